@@ -0,0 +1,64 @@
+"""
+@ Qufilab, 2020.
+
+Benchmark of the windowed indicators on a single long series for a
+number of threads.
+
+cmo, mfi, cci, willr and cmf split long series into chunks that are
+calculated in parallel, see qufilab/core/halo.h. Each thread count is
+timed in its own interpreter with OMP_NUM_THREADS set.
+
+Usage: python benchmarks/halo.py [size] [threads ...]
+"""
+import os
+import subprocess
+import sys
+import timeit
+import numpy as np
+
+import qufilab as ql
+
+
+def run(size):
+    np.random.seed(0)
+    close = np.random.rand(size) * 100 + 100
+    high = close + np.random.rand(size)
+    low = close - np.random.rand(size)
+    volume = np.random.rand(size) * 1000
+
+    cases = [
+        ("cmo", lambda: ql.cmo(close, 20)),
+        ("mfi", lambda: ql.mfi(high, low, close, volume, 20)),
+        ("cci", lambda: ql.cci(close, high, low, 20)),
+        ("willr", lambda: ql.willr(close, high, low, 20)),
+        ("cmf", lambda: ql.cmf(close, high, low, volume, 21)),
+    ]
+
+    for name, func in cases:
+        t = min(timeit.repeat(func, number = 1, repeat = 5))
+        print("{} {}".format(name, t))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) > 2 and sys.argv[1] == "--run":
+        run(int(sys.argv[2]))
+        sys.exit(0)
+
+    size = int(sys.argv[1]) if len(sys.argv) > 1 else 10000000
+    threads = [int(arg) for arg in sys.argv[2:]] or [1, 2, 4, 8]
+    times = {}
+
+    for n_threads in threads:
+        env = dict(os.environ, OMP_NUM_THREADS = str(n_threads))
+        output = subprocess.check_output(
+                [sys.executable, __file__, "--run", str(size)], env = env)
+        for line in output.decode().splitlines():
+            name, t = line.split()
+            times.setdefault(name, []).append(float(t))
+
+    print("{} values".format(size))
+    print("{:>10}".format("indicator") +
+            "".join("{:>12}".format("{} threads".format(n)) for n in threads))
+
+    for name, row in times.items():
+        print("{:>10}".format(name) + "".join("{:>12.4f}".format(t) for t in row))
@@ -0,0 +1,67 @@
+"""
+@ Qufilab, 2020.
+
+Benchmark of the time and memory it takes to import qufilab.
+
+The indicator and pattern modules are compiled into the single extension
+qufilab._qufilab, instead of one extension per module that each contained
+its own copy of _trend.cc. Each import is timed in a fresh interpreter,
+after numpy is imported, so only qufilab itself is measured. On Linux the
+number and size of the qufilab extensions mapped by the process, and the
+resident memory after the import, are reported as well. Run it with a build
+of each version to compare them.
+
+Usage: python benchmarks/import_time.py [repeats]
+"""
+import json
+import os
+import subprocess
+import sys
+
+MEASURE = """
+import json, os, time
+import numpy
+
+start = time.perf_counter()
+import qufilab
+elapsed = time.perf_counter() - start
+
+package = os.path.dirname(qufilab.__file__)
+extensions, mapped = set(), 0
+if os.path.exists("/proc/self/maps"):
+    with open("/proc/self/maps") as maps:
+        for line in maps:
+            fields = line.split()
+            if len(fields) == 6 and fields[5].startswith(package) and ".so" in fields[5]:
+                begin, end = (int(address, 16) for address in fields[0].split("-"))
+                extensions.add(fields[5])
+                mapped += end - begin
+
+rss = 0
+if os.path.exists("/proc/self/status"):
+    with open("/proc/self/status") as status:
+        for line in status:
+            if line.startswith("VmRSS:"):
+                rss = int(line.split()[1]) * 1024
+
+print(json.dumps({"time": elapsed, "extensions": len(extensions),
+    "mapped": mapped, "rss": rss}))
+"""
+
+
+if __name__ == "__main__":
+    repeats = int(sys.argv[1]) if len(sys.argv) > 1 else 20
+
+    runs = []
+    for _ in range(repeats):
+        output = subprocess.check_output([sys.executable, "-c", MEASURE],
+                env = dict(os.environ, OMP_NUM_THREADS = "1"))
+        runs.append(json.loads(output.decode().splitlines()[-1]))
+
+    times = sorted(run["time"] for run in runs)
+    print("{} imports".format(repeats))
+    print("{:>20}{:>12.2f}".format("min time (ms)", times[0] * 1000))
+    print("{:>20}{:>12.2f}".format("median time (ms)", times[len(times) // 2] * 1000))
+    print("{:>20}{:>12}".format("extensions", runs[-1]["extensions"]))
+    print("{:>20}{:>12.1f}".format("mapped (MiB)", runs[-1]["mapped"] / 2 ** 20))
+    print("{:>20}{:>12.1f}".format("rss (MiB)", runs[-1]["rss"] / 2 ** 20))
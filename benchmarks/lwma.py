@@ -0,0 +1,44 @@
+"""
+@ Qufilab, 2020.
+
+Benchmark of the linear weighted moving average.
+
+Compares qufilab.lwma, which keeps running sums and is O(n), with a
+windowed O(n * period) reference that recalculates the full weighted
+window for every value, i.e. how lwma was calculated before.
+
+Usage: python benchmarks/lwma.py [size]
+"""
+import sys
+import timeit
+import numpy as np
+
+import qufilab as ql
+
+
+def lwma_windowed(data, periods):
+    """
+    Reference lwma that recalculates the whole weighted window.
+    """
+    weights = np.arange(periods, 0, -1, dtype = np.float64)
+    lwma = np.full(data.shape, np.nan)
+    lwma[periods - 1:] = np.convolve(data, weights, "valid") / weights.sum()
+    return lwma
+
+
+if __name__ == "__main__":
+    size = int(sys.argv[1]) if len(sys.argv) > 1 else 10000000
+    data = np.random.rand(size) * 100 + 100
+
+    print("lwma, {} values".format(size))
+    print("{:>8} {:>12} {:>12} {:>12}".format("period", "qufilab [s]",
+        "windowed [s]", "max rel diff"))
+
+    for periods in [10, 50, 200, 500]:
+        t_ql = min(timeit.repeat(lambda: ql.lwma(data, periods), number = 1, repeat = 3))
+        t_ref = min(timeit.repeat(lambda: lwma_windowed(data, periods), number = 1, repeat = 3))
+
+        q = ql.lwma(data, periods)
+        r = lwma_windowed(data, periods)
+        diff = np.nanmax(np.abs(q - r) / np.abs(r))
+        print("{:>8} {:>12.4f} {:>12.4f} {:>12.2e}".format(periods, t_ql, t_ref, diff))
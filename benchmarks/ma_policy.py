@@ -0,0 +1,44 @@
+"""
+@ Qufilab, 2020.
+
+Benchmark of the indicators with a selectable variant.
+
+apo and ppo (moving average 'sma' or 'ema'), rsi ('smoothed' or 'standard')
+and the two kinds of hammer, engulfing and harami patterns resolve the
+variant string once per call, and run a kernel instantiated for that
+variant. Run this on the commit before and after the change to compare.
+
+Usage: python benchmarks/ma_policy.py [size]
+"""
+import sys
+import timeit
+import numpy as np
+
+import qufilab as ql
+
+
+if __name__ == "__main__":
+    size = int(sys.argv[1]) if len(sys.argv) > 1 else 1000000
+    close = np.random.rand(size) * 100 + 100
+    open_ = close + np.random.randn(size)
+    high = np.maximum(close, open_) + np.random.rand(size)
+    low = np.minimum(close, open_) - np.random.rand(size)
+
+    cases = [
+        ("apo sma", lambda: ql.apo(close, 26, 12, "sma")),
+        ("apo ema", lambda: ql.apo(close, 26, 12, "ema")),
+        ("ppo sma", lambda: ql.ppo(close, 12, 26, "sma")),
+        ("ppo ema", lambda: ql.ppo(close, 12, 26, "ema")),
+        ("rsi smoothed", lambda: ql.rsi(close, 14, "smoothed")),
+        ("hammer", lambda: ql.hammer(high, low, open_, close)),
+        ("inverted_hammer", lambda: ql.inverted_hammer(high, low, open_, close)),
+        ("engulfing_bull", lambda: ql.engulfing_bull(high, low, open_, close)),
+        ("harami_bear", lambda: ql.harami_bear(high, low, open_, close)),
+    ]
+
+    print("{} values".format(size))
+    print("{:>16} {:>12}".format("indicator", "time [s]"))
+
+    for name, func in cases:
+        t = min(timeit.repeat(func, number = 1, repeat = 5))
+        print("{:>16} {:>12.4f}".format(name, t))
@@ -0,0 +1,63 @@
+"""
+@ Qufilab, 2020.
+
+Benchmark of indicators called from several python threads at once.
+
+The indicators release the GIL while they calculate, so the throughput
+should grow with the number of python threads, up to the number of cores.
+OpenMP is limited to one thread (OMP_NUM_THREADS) unless it is already set,
+so that only the python threads run in parallel.
+
+Usage: python benchmarks/threads.py [size] [threads ...]
+"""
+import os
+os.environ.setdefault("OMP_NUM_THREADS", "1")
+
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+import numpy as np
+
+import qufilab as ql
+
+
+def work(data):
+    close, high, low, open_, volume = data
+    ql.sma(close, 20)
+    ql.ema(close, 20)
+    ql.rsi(close, 14)
+    ql.atr(close, high, low, 14)
+    ql.bbands(close, 20)
+    ql.mfi(high, low, close, volume, 14)
+    ql.hammer(high, low, open_, close)
+
+
+if __name__ == "__main__":
+    size = int(sys.argv[1]) if len(sys.argv) > 1 else 100000
+    threads = [int(arg) for arg in sys.argv[2:]] or [1, 2, 4, 8]
+    n_tasks = 64
+
+    np.random.seed(0)
+    tasks = []
+    for _ in range(n_tasks):
+        close = np.random.rand(size) * 100 + 100
+        high = close + np.random.rand(size)
+        low = close - np.random.rand(size)
+        open_ = low + (high - low) * np.random.rand(size)
+        volume = np.random.rand(size) * 1000
+        tasks.append((close, high, low, open_, volume))
+
+    print("{} tasks of {} values".format(n_tasks, size))
+    print("{:>10}{:>12}{:>12}".format("threads", "tasks/s", "speedup"))
+
+    base = None
+    for n_threads in threads:
+        with ThreadPoolExecutor(n_threads) as executor:
+            list(executor.map(work, tasks[:n_threads]))
+
+            start = time.perf_counter()
+            list(executor.map(work, tasks))
+            throughput = n_tasks / (time.perf_counter() - start)
+
+        base = base or throughput
+        print("{:>10}{:>12.1f}{:>12.2f}".format(n_threads, throughput, throughput / base))
@@ -0,0 +1,63 @@
+"""
+@ Qufilab, 2020.
+
+Benchmark of the true range based indicators for each SIMD level.
+
+trange, atr and kc calculate the true range with the SSE2, AVX2 or AVX-512
+variant selected at import, see qufilab/core/simd.h. Each level is
+timed in its own interpreter with QUFILAB_SIMD set, levels the CPU doesn't
+support run the best supported one instead.
+
+Usage: python benchmarks/true_range.py [size]
+"""
+import os
+import subprocess
+import sys
+import timeit
+import numpy as np
+
+import qufilab as ql
+
+
+LEVELS = ["scalar", "sse2", "avx2", "avx512"]
+
+
+def run(size):
+    np.random.seed(0)
+    close = np.random.rand(size) * 100 + 100
+    high = close + np.random.rand(size)
+    low = close - np.random.rand(size)
+
+    cases = [
+        ("trange", lambda: ql.trange(close, high, low)),
+        ("atr", lambda: ql.atr(close, high, low, 14)),
+        ("kc", lambda: ql.kc(close, high, low, 20, 20)),
+    ]
+
+    for name, func in cases:
+        t = min(timeit.repeat(func, number = 1, repeat = 5))
+        print("{} {}".format(name, t))
+
+
+if __name__ == "__main__":
+    if len(sys.argv) > 2 and sys.argv[1] == "--run":
+        run(int(sys.argv[2]))
+        sys.exit(0)
+
+    size = int(sys.argv[1]) if len(sys.argv) > 1 else 10000000
+    times = {}
+
+    for level in LEVELS:
+        env = dict(os.environ, QUFILAB_SIMD = level)
+        output = subprocess.check_output(
+                [sys.executable, __file__, "--run", str(size)], env = env)
+        for line in output.decode().splitlines():
+            name, t = line.split()
+            times.setdefault(name, []).append(float(t))
+
+    print("{} values".format(size))
+    print("{:>10}".format("indicator") +
+            "".join("{:>12}".format(level) for level in LEVELS))
+
+    for name, row in times.items():
+        print("{:>10}".format(name) + "".join("{:>12.4f}".format(t) for t in row))
@@ -51,7 +51,7 @@ def linkcode_resolve(domain, info):
             data = yaml.safe_load(stream)
             for indicator_type, indicators in data.items():
                 if fullname in indicators:
-                    filename = "qufilab/indicators/_"+indicator_type+".cc"
+                    filename = "qufilab/core/"+indicator_type+".h"
                     break
 
         except yaml.YAMLError as exc:
@@ -61,7 +61,7 @@ def linkcode_resolve(domain, info):
     # Start is given by "Implementation of SMA" for example, and end is given by
     # "return sma", for example.
     github_url = "https://github.com/normelius/qufilab/blob/master/qufilab/" \
-            "indicators/_{}.cc".format(indicator_type)
+            "core/{}.h".format(indicator_type)
     
     r = requests.get(github_url)
     soup = bs(r.text, 'html.parser')
@@ -74,7 +74,7 @@ def linkcode_resolve(domain, info):
         lineno = 1
 
     url = 'https://github.com/normelius/qufilab/blob/master/' \
-            'qufilab/indicators/_{}.cc#{}'.format(indicator_type,
+            'qufilab/core/{}.h#{}'.format(indicator_type,
                     lineno)
     return url
 
@@ -82,15 +82,15 @@ def linkcode_resolve(domain, info):
 # External links to be used for urls to correct source code part on github.
 extlinks = {
         'trend': ('https://github.com/normelius/qufilab/blob/'\
-        'master/qufilab/indicators/_trend.cc#%s', ''),
+        'master/qufilab/core/trend.h#%s', ''),
         'momentum': ('https://github.com/normelius/qufilab/blob/'\
-        'master/qufilab/indicators/_momentum.cc#%s', ''),
+        'master/qufilab/core/momentum.h#%s', ''),
         'volatility': ('https://github.com/normelius/qufilab/blob/'\
-        'master/qufilab/indicators/_volatility.cc#%s', ''),
+        'master/qufilab/core/volatility.h#%s', ''),
         'volume': ('https://github.com/normelius/qufilab/blob/'\
-        'master/qufilab/indicators/_volume.cc#%s', ''),
+        'master/qufilab/core/volume.h#%s', ''),
         'stat': ('https://github.com/normelius/qufilab/blob/'\
-        'master/qufilab/indicators/_stat.cc#%s', '')
+        'master/qufilab/core/stat.h#%s', '')
         }
 
 
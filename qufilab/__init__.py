@@ -1,12 +1,17 @@
 #from .main import Models
 #from .indicators.interface import *
 
+# Extension, which registers the submodules qufilab.indicators._trend etc.
+# that the modules below import from.
+from . import _qufilab
+
 # Indicators
 from .indicators.trend import *
 from .indicators.stat import *
 from .indicators.volume import *
 from .indicators.volatility import *
 from .indicators.momentum import *
+from .indicators.simd import *
 
 # Patterns
 from .patterns.bullish import *
@@ -0,0 +1,43 @@
+/*
+ *  @QufiLab, Anton Normelius, 2020.
+ *
+ *  Single extension with all indicator and pattern modules as submodules,
+ *  so that the kernels they share are compiled and loaded once.
+ *
+ */
+
+#include <string>
+#include <pybind11/pybind11.h>
+
+#include "indicators/_trend.h"
+#include "indicators/_volatility.h"
+#include "indicators/_momentum.h"
+#include "indicators/_volume.h"
+#include "indicators/_stat.h"
+#include "patterns/_bullish.h"
+
+namespace py = pybind11;
+
+/*
+ *  Adds the submodule name to m, and registers it as package.name in
+ *  sys.modules and as an attribute of package, so it's imported and
+ *  accessed with the name of the former extension, e.g.
+ *  qufilab.indicators._trend.
+ */
+void add_submodule(py::module &m, const std::string &package,
+        const char *name, void (*init)(py::module &)) {
+    py::module submodule = m.def_submodule(name);
+    init(submodule);
+
+    py::module::import("sys").attr("modules")[py::str(package + "." + name)] = submodule;
+    py::module::import(package.c_str()).attr(name) = submodule;
+}
+
+PYBIND11_MODULE(_qufilab, m) {
+    add_submodule(m, "qufilab.indicators", "_trend", &init_trend);
+    add_submodule(m, "qufilab.indicators", "_volatility", &init_volatility);
+    add_submodule(m, "qufilab.indicators", "_momentum", &init_momentum);
+    add_submodule(m, "qufilab.indicators", "_volume", &init_volume);
+    add_submodule(m, "qufilab.indicators", "_stat", &init_stat);
+    add_submodule(m, "qufilab.patterns", "_bullish", &init_bullish);
+}
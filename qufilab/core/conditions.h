@@ -8,12 +8,18 @@
 #ifndef CONDITIONS_H
 #define CONDITIONS_H
 
-#include <string>
-#include <pybind11/pybind11.h>
-#include <pybind11/numpy.h>
-
 #include "candlestick.h"
 
+/*
+ *  Variants of the patterns that come in two kinds. The variant is a
+ *  template parameter of the conditions, so the string from python is
+ *  resolved once per call (see pattern_direction and hammer_type in
+ *  patterns/pattern_utility.h) instead of being compared for every
+ *  candlestick.
+ */
+enum class Direction { bull, bear };
+enum class HammerType { hammer, inverted_hammer };
+
 /*
  *  Conditions for HAMMER.
  *  
@@ -21,7 +27,7 @@
  *      candle (Candlestick<T>) : A struct candlestick containing the 
  *          data for a single candlestick.
  *      shadow_margin (T) : Specify shadow margin for the upper shadow.
- *      type (T) : Specify whether 'hammer' or 'inverted_hammer' should
+ *      type (HammerType) : Specify whether hammer or inverted hammer should
  *          be calculated.
  *
  *  Definition for this implementation:
@@ -43,20 +49,19 @@
  *      - Upper shadow bigger than 2x the body size. Observe that some references
  *          specify that the upper shadow should be between 2-3 times the body.
  */
-template <typename T>
-bool hammer_conditions(Candlestick<T> candle, const T shadow_margin, 
-        std::string type) {
+template <HammerType type, typename T>
+bool hammer_conditions(Candlestick<T> candle, const T shadow_margin) {
 
     bool candle_conditions;
 
-    if (type == "hammer") {
+    if (type == HammerType::hammer) {
         candle_conditions = candle.has_short_body() && 
             !candle.has_doji_body() && 
             !candle.has_upper_shadow(shadow_margin) &&
             candle.lower_shadow >= candle.body * 2;
     }
 
-    else if (type == "inverted_hammer") {
+    else {
         candle_conditions = candle.has_short_body() &&
             !candle.has_doji_body() && 
             !candle.has_lower_shadow(shadow_margin) &&
@@ -187,12 +192,11 @@ bool spinning_top_white_conditions(Candlestick<T> candle) {
 /*
  *  Conditions for ENGULFING.
  */
-template <typename T>
-bool engulfing_conditions(Candlestick<T> candle, Candlestick<T> candle_prev,
-        const std::string type) {
+template <Direction type, typename T>
+bool engulfing_conditions(Candlestick<T> candle, Candlestick<T> candle_prev) {
     bool candle_cond, candle_prev_cond;
 
-    if (type == "bull") {
+    if (type == Direction::bull) {
         candle_prev_cond = candle_prev.is_red() && candle_prev.has_short_body();
 
         candle_cond = candle.is_green() && candle.has_long_body() &&
@@ -200,7 +204,7 @@ bool engulfing_conditions(Candlestick<T> candle, Candlestick<T> candle_prev,
         (candle.open < candle_prev.close || candle.close > candle_prev.open);
     }
             
-    else if (type == "bear") {
+    else {
         candle_prev_cond = candle_prev.is_green() && candle_prev.has_short_body();
 
         candle_cond = candle.is_red() && candle.has_long_body() &&
@@ -239,13 +243,12 @@ bool engulfing_conditions(Candlestick<T> candle, Candlestick<T> candle_prev,
  *          however NOT a doji.
  *      - Current candle color does not matter.
  */
-template <typename T>
-bool harami_conditions(Candlestick<T> candle, Candlestick<T> candle_prev,
-        std::string type) {
+template <Direction type, typename T>
+bool harami_conditions(Candlestick<T> candle, Candlestick<T> candle_prev) {
 
     bool candle_cond, candle_prev_cond;
 
-    if (type == "bull") {
+    if (type == Direction::bull) {
         candle_prev_cond = candle_prev.has_long_body() &&
             candle_prev.is_red() &&
             (candle_prev.body_low <= candle.body_low &&
@@ -256,7 +259,7 @@ bool harami_conditions(Candlestick<T> candle, Candlestick<T> candle_prev,
         candle_cond = candle.has_short_body() && !candle.has_doji_body();
     }
 
-    else if (type == "bear") {
+    else {
         candle_prev_cond = candle_prev.has_long_body() &&
             candle_prev.is_green() &&
             (candle_prev.body_low <= candle.body_low &&
@@ -285,13 +288,13 @@ bool harami_conditions(Candlestick<T> candle, Candlestick<T> candle_prev,
  *          - Current candle needs to be a long red marubozu candle.
  */
 
-template <typename T>
+template <Direction type, typename T>
 bool kicking_conditions(Candlestick<T> candle, Candlestick<T> candle_prev,
-        const float shadow_margin, const std::string type) {
+        const float shadow_margin) {
 
     bool candle_cond, candle_prev_cond;
 
-    if (type == "bull") {
+    if (type == Direction::bull) {
         candle_cond = candle.has_long_body() && candle.is_green() &&
             candle.is_marubozu(shadow_margin) && 
             (candle.low > candle_prev.high);
@@ -300,7 +303,7 @@ bool kicking_conditions(Candlestick<T> candle, Candlestick<T> candle_prev,
             candle_prev.is_red() && candle_prev.is_marubozu(shadow_margin);
     }
 
-    else if (type == "bear") {
+    else {
         candle_cond = candle.has_long_body() && candle.is_red() &&
             candle.is_marubozu(shadow_margin) && 
             (candle.high < candle_prev.low);
@@ -381,19 +384,19 @@ bool tws_conditions(Candlestick<T> c1, Candlestick<T> c2,
  *              of both side candles.
  *          - Third candle is red with shadows that gaps below the middle doji.
  */
-template <typename T>
+template <Direction type, typename T>
 bool abandoned_baby_conditions(Candlestick<T> c1, Candlestick<T> c2,
-        Candlestick<T> c3, std::string type) {
+        Candlestick<T> c3) {
     
     bool c1_conditions, c2_conditions, c3_conditions;
 
-    if (type == "bull") {
+    if (type == Direction::bull) {
         c3_conditions = c3.is_red();
         c2_conditions = c2.has_doji_body() && (c2.high < c3.low);
         c1_conditions = c1.is_green() & (c1.low > c2.high);
     }
 
-    else if (type == "bear") {
+    else {
         c3_conditions = c3.is_green();
         c2_conditions = c2.has_doji_body() && (c2.low > c3.high);
         c1_conditions = c1.is_red() & (c1.high < c2.low);
@@ -416,13 +419,12 @@ bool abandoned_baby_conditions(Candlestick<T> c1, Candlestick<T> c2,
  *          - No upper shadow.
  *          - No or small lower shadow.
  */
-template <typename T>
-bool belthold_conditions(Candlestick<T> candle, std::string type,
-        const float shadow_margin) {
+template <Direction type, typename T>
+bool belthold_conditions(Candlestick<T> candle, const float shadow_margin) {
     
     bool candle_conditions;
 
-    if (type == "bull") {
+    if (type == Direction::bull) {
         candle_conditions = candle.is_green() && 
             candle.has_long_body() &&
             !candle.has_lower_shadow(0.0) && 
@@ -430,7 +432,7 @@ bool belthold_conditions(Candlestick<T> candle, std::string type,
             !candle.has_upper_shadow(shadow_margin*2);
     }
 
-    else if (type == "bear") {
+    else {
         candle_conditions = candle.is_red() && 
             candle.has_long_body() &&
             !candle.has_upper_shadow(0.0) &&
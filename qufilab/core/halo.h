@@ -0,0 +1,127 @@
+#ifndef INDICATOR_HALO_H
+#define INDICATOR_HALO_H
+
+#include <vector>
+#include <cstddef>
+#include <cmath>
+#include <algorithm>
+
+/*
+ *  Windowed indicators (cmo, mfi, cci, willr, cmf) on long series.
+ *
+ *  The value at idx only depends on the inputs in [idx - halo, idx], so a
+ *  long series is split into chunks of at least HALO_CHUNK bars that are
+ *  calculated in parallel. The kernel is called for each chunk with the
+ *  halo bars before it, into a per-thread buffer, and the values after the
+ *  halo are copied to the output. The first chunk has no halo and is
+ *  calculated directly into the output.
+ *
+ *  The chunks don't depend on the number of threads, so neither do the
+ *  results. Chunks start at multiples of align, which lets cmf recalculate
+ *  its sums at the same bars as the serial loop. Kernels with running sums
+ *  that are never recalculated (cmo, mfi, cci) start them again in each
+ *  chunk, and differ from the serial loop by the rounding of the sums. sma
+ *  isn't chunked, it's limited by memory bandwidth rather than the loop, and
+ *  keeps the same values as SmaState.
+ *
+ *  In those kernels a NaN or infinite value stays in the running sums, and
+ *  every later value is NaN. Unless nan_local is set, i.e. the kernel only
+ *  gives NaN while such a value is in the window, series with them (leading
+ *  NaNs included) are calculated by the serial loop instead. This is decided
+ *  by a pass over the inputs before any chunk is calculated, so such series
+ *  are only calculated once.
+ *
+ *  Series of a 2D panel are already calculated in parallel by panel_calc,
+ *  and the nested parallel region runs on a single thread.
+ */
+
+// Minimum number of bars per chunk.
+#define HALO_CHUNK 262144
+
+template <typename T>
+bool all_finite(const T *values_ptr, const int begin, const int end) {
+    bool finite = true;
+    for (int idx = begin; idx < end; ++idx) {
+        finite &= std::isfinite(values_ptr[idx]);
+    }
+
+    return finite;
+}
+
+/*
+ *  Calls kernel(inputs, outputs, size) like panel_calc, for the series in
+ *  in and out with size bars, one chunk at a time.
+ */
+template <typename T, typename Kernel>
+void halo_calc(const T * const *in, const int n_inputs, T * const *out,
+        const int n_outputs, const int size, const int halo, const int align,
+        const bool nan_local, Kernel kernel) {
+
+    if (halo < 0 || align < 1 || halo >= size / 4) {
+        kernel(in, out, size);
+        return;
+    }
+
+    int chunk = std::max(HALO_CHUNK, 4 * halo);
+    chunk = (chunk + align - 1) / align * align;
+    const int n_chunks = (size - 1) / chunk + 1;
+
+    if (n_chunks == 1) {
+        kernel(in, out, size);
+        return;
+    }
+
+    if (!nan_local) {
+        bool finite = true;
+
+        #pragma omp parallel for schedule(static) reduction(&&:finite)
+        for (int block = 0; block < n_chunks; ++block) {
+            const int begin = block * chunk;
+            const int end = std::min(size, begin + chunk);
+
+            for (int ii = 0; ii < n_inputs; ++ii) {
+                finite = finite && all_finite(in[ii], begin, end);
+            }
+        }
+
+        if (!finite) {
+            kernel(in, out, size);
+            return;
+        }
+    }
+
+    #pragma omp parallel
+    {
+        std::vector<T> buffer(n_outputs * (std::size_t) (chunk + halo));
+        std::vector<const T *> chunk_in(n_inputs);
+        std::vector<T *> chunk_out(n_outputs);
+
+        #pragma omp for schedule(static)
+        for (int block = 0; block < n_chunks; ++block) {
+            const int begin = block * chunk;
+            const int end = std::min(size, begin + chunk);
+
+            if (block == 0) {
+                kernel(in, out, end);
+                continue;
+            }
+
+            for (int ii = 0; ii < n_inputs; ++ii) {
+                chunk_in[ii] = in[ii] + begin - halo;
+            }
+
+            for (int ii = 0; ii < n_outputs; ++ii) {
+                chunk_out[ii] = buffer.data() + ii * (std::size_t) (chunk + halo);
+            }
+
+            kernel(chunk_in.data(), chunk_out.data(), end - begin + halo);
+
+            for (int ii = 0; ii < n_outputs; ++ii) {
+                std::copy(chunk_out[ii] + halo, chunk_out[ii] + halo + end - begin,
+                        out[ii] + begin);
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,667 @@
+#ifndef CORE_MOMENTUM_H
+#define CORE_MOMENTUM_H
+
+#include <vector>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "util.h"
+#include "rolling.h"
+#include "simd.h"
+#include "scan.h"
+#include "trend.h"
+
+/*
+ *  Momentum indicators, kernels working on a single series of size values
+ *  (see trend.h).
+ */
+
+/*
+ *  How rsi averages the gains and losses, Wilder's smoothing or the simple
+ *  average over the window (Cutler). The string from python is resolved to
+ *  this once per call.
+ */
+enum class RsiType { smoothed, standard };
+
+/*
+*   Gain and loss of a single price change. NaN changes count as neither.
+*/
+template <typename T>
+inline T rsi_gain(const T diff) {
+    return diff > 0 ? diff : (T) 0.0;
+}
+
+template <typename T>
+inline T rsi_loss(const T diff) {
+    return diff < 0 ? (T) (diff * -1.0) : (T) 0.0;
+}
+
+// Number of bars of the smoothed rsi that are scanned at a time.
+#define RSI_CHUNK (16 * SCAN_BLOCK)
+
+/*
+*   Implementation of RSI.
+*
+*   The gains and losses are calculated from the price changes as they are
+*   needed. The smoothed average gain and loss are linear recurrences,
+*   scanned together with affine_scan (see scan.h) into a buffer of
+*   RSI_CHUNK bars at a time.
+*
+*   @param prices (const T *): Array with prices.
+*   @param periods (int): Number of periods.
+*   @param type (RsiType): Specifies how the following gains/losses 
+*       shall be calculated. Smoothed (Wilder) or standard, i.e. the simple
+*       average over the last periods changes (Cutler).
+*/
+template <typename T, RsiType type>
+void rsi_kernel(const T *prices_ptr, T *rsi_ptr, const int size,
+        const int periods) {
+
+    if (periods < 1) {
+        init_nan(rsi_ptr, size);
+        return;
+    }
+
+    init_nan(rsi_ptr, std::min(size, periods));
+
+    if (periods >= size) {
+        return;
+    }
+
+    // First average gain/loss.
+    T AG = 0.0;
+    T AL = 0.0;
+
+    // Number of gains/losses in the window, used by the standard rsi to
+    // reset the running sums to exactly zero when the window has none.
+    int gains = 0;
+    int losses = 0;
+
+    for (int idx = 1; idx <= periods; ++idx) {
+        T diff = prices_ptr[idx] - prices_ptr[idx-1];
+        AG += rsi_gain(diff);
+        AL += rsi_loss(diff);
+        gains += diff > 0;
+        losses += diff < 0;
+    }
+
+    if (type == RsiType::smoothed) {
+        AG /= periods;
+        AL /= periods;
+
+        auto update = [=](const ScanPair<T> prev, const int idx) {
+            T diff = prices_ptr[idx] - prices_ptr[idx-1];
+            ScanPair<T> next = {((prev.first * (periods-1)) + rsi_gain(diff)) / periods,
+                ((prev.second * (periods-1)) + rsi_loss(diff)) / periods};
+            return next;
+        };
+
+        std::vector<ScanPair<T>> buffer(std::min(size - periods, RSI_CHUNK));
+        ScanPair<T> *buffer_ptr = buffer.data();
+        ScanPair<T> average = {AG, AL};
+
+        for (int begin = periods; begin < size; begin += RSI_CHUNK) {
+            const int end = std::min(size, begin + RSI_CHUNK);
+            if (begin > periods) {
+                average = update(average, begin);
+            }
+
+            affine_scan(buffer_ptr, 0, end - begin, average, (T) (periods - 1) / periods,
+                [=](const ScanPair<T> prev, const int idx) {
+                    return update(prev, begin + idx);
+                });
+
+            average = buffer_ptr[end-1-begin];
+
+            #pragma omp parallel for schedule(static) if (end - begin > SCAN_BLOCK)
+            for (int idx = begin; idx < end; ++idx) {
+                const ScanPair<T> &value = buffer_ptr[idx-begin];
+                rsi_ptr[idx] = 100 - (100 / (1 + (value.first / value.second)));
+            }
+        }
+    }
+
+    else {
+        // AG and AL are kept as sums over the window, which have the same
+        // ratio as the averages.
+        rsi_ptr[periods] = 100 - (100 / (1 + (AG / AL)));
+
+        for (int idx = periods+1; idx < size; ++idx) {
+            T diff = prices_ptr[idx] - prices_ptr[idx-1];
+            T diff_out = prices_ptr[idx-periods] - prices_ptr[idx-periods-1];
+
+            AG += rsi_gain(diff) - rsi_gain(diff_out);
+            AL += rsi_loss(diff) - rsi_loss(diff_out);
+            gains += (diff > 0) - (diff_out > 0);
+            losses += (diff < 0) - (diff_out < 0);
+
+            if (gains == 0) {
+                AG = 0.0;
+            }
+
+            if (losses == 0) {
+                AL = 0.0;
+            }
+
+            rsi_ptr[idx] = 100 - (100 / (1 + (AG / AL)));
+        }
+    }
+}
+
+/*
+*   Smoothed RSI for PANEL_LANES series at once, stepping through time together
+*   so that each series is kept in its own SIMD lane, see panel.h. The
+*   arithmetic per series is the serial recurrence of the smoothed
+*   rsi_kernel, so the values are the same for the first SCAN_BLOCK bars.
+*/
+template <typename T>
+bool rsi_lanes_kernel(const T *prices_ptr, const std::ptrdiff_t prices_step,
+        T *rsi_ptr, const std::ptrdiff_t rsi_step, const int size,
+        const int periods) {
+
+    if (periods < 1 || periods >= size) {
+        return false;
+    }
+
+    for (int idx = 0; idx < periods; ++idx) {
+        std::fill(rsi_ptr + idx * rsi_step, rsi_ptr + idx * rsi_step + PANEL_LANES,
+                std::numeric_limits<T>::quiet_NaN());
+    }
+
+    T AG[PANEL_LANES] = {0.0};
+    T AL[PANEL_LANES] = {0.0};
+
+    // First average gain/loss.
+    for (int idx = 1; idx <= periods; ++idx) {
+        const T *price = prices_ptr + idx * prices_step;
+        const T *price_prev = price - prices_step;
+
+        for (int lane = 0; lane < PANEL_LANES; ++lane) {
+            T diff = price[lane] - price_prev[lane];
+            AG[lane] += rsi_gain(diff);
+            AL[lane] += rsi_loss(diff);
+        }
+    }
+
+    for (int lane = 0; lane < PANEL_LANES; ++lane) {
+        AG[lane] /= periods;
+        AL[lane] /= periods;
+        rsi_ptr[periods * rsi_step + lane] = 100 - (100 / (1 + (AG[lane] / AL[lane])));
+    }
+
+    for (int idx = periods+1; idx < size; ++idx) {
+        const T *price = prices_ptr + idx * prices_step;
+        const T *price_prev = price - prices_step;
+        T *rsi = rsi_ptr + idx * rsi_step;
+
+        #pragma omp simd
+        for (int lane = 0; lane < PANEL_LANES; ++lane) {
+            T diff = price[lane] - price_prev[lane];
+            AG[lane] = ((AG[lane] * (periods-1)) + rsi_gain(diff)) / periods;
+            AL[lane] = ((AL[lane] * (periods-1)) + rsi_loss(diff)) / periods;
+            rsi[lane] = 100 - (100 / (1 + (AG[lane] / AL[lane])));
+        }
+    }
+
+    return true;
+}
+
+/*
+ *  Implementation of MACD.
+ *
+*   @param prices (vector<double>): Vector with prices.
+*   @param default_size (bool): Specify whether returned vector should be same length
+*       filled with NaNs.
+*/
+
+template <typename T>
+void macd_kernel(const T *prices_ptr, T *macd_ptr, T *signal_ptr, const int size) {
+    init_nan(macd_ptr, std::min(size, 25));
+    init_nan(signal_ptr, std::min(size, 33));
+
+    std::vector<T> ema26(size);
+    std::vector<T> ema12(size);
+    ema_kernel(prices_ptr, ema26.data(), size, 26);
+    ema_kernel(prices_ptr, ema12.data(), size, 12);
+    
+    for (int idx = 25; idx < size; ++idx) {
+        macd_ptr[idx] = ema12[idx] - ema26[idx];
+    }
+
+    // Not enough values for the first signal value.
+    if (size < 34) {
+        return;
+    }
+    
+    T k = (T) 2 / (10);
+    // SMA for the first signal value.
+    T prev = std::accumulate(macd_ptr + 25, macd_ptr + 34, 0.0) / 9;
+    signal_ptr[33] = prev;
+    
+    // EMA for the rest.
+    for (int idx = 34; idx < size; ++idx) {
+        prev = (macd_ptr[idx] - prev) * k + prev;
+        signal_ptr[idx] = prev;
+    }
+}
+
+/*
+*   Implementation of WILLR.
+*
+*   @param prices (vector<double>): Vector with closing prices.
+*   @param highs (vector<double>): Vector with high prices.
+*   @param lows (vector<double>): Vector with low prices.
+*   @param periods (int): Number of periods.
+ */
+template <typename T>
+void willr_kernel(const T *prices_ptr, const T *highs_ptr, const T *lows_ptr,
+        T *will_ptr, const int size, const int periods) {
+
+    if (periods < 1) {
+        init_nan(will_ptr, size);
+        return;
+    }
+
+    init_nan(will_ptr, std::min(size, periods - 1));
+
+    // Highest high and lowest low over the window, see rolling.h.
+    RollingMax<T> highest(highs_ptr, periods);
+    RollingMin<T> lowest(lows_ptr, periods);
+
+    for (int idx = 0; idx < size; ++idx) {
+        highest.push(idx);
+        lowest.push(idx);
+
+        if (idx < periods - 1) {
+            continue;
+        }
+
+        if (highest.has_nan(idx) || lowest.has_nan(idx)) {
+            will_ptr[idx] = std::numeric_limits<T>::quiet_NaN();
+            continue;
+        }
+
+        T max = highs_ptr[highest.front()];
+        T min = lows_ptr[lowest.front()];
+        will_ptr[idx] = ((max - prices_ptr[idx]) / (max - min)) * -100.0;
+    }
+}
+
+/*
+*   Implementation of ROC.
+*
+*   Math: (price_now - price_periods) / (price_periods) * 100;
+*   @param prices (vector<double>): Vector with closing prices.
+*   @param periods (int): Number of periods.
+*/
+template <typename T>
+void roc_kernel(const T *prices_ptr, T *roc_ptr, const int size, const int periods) {
+    if (periods < 1) {
+        init_nan(roc_ptr, size);
+        return;
+    }
+
+    init_nan(roc_ptr, std::min(size, periods));
+    
+    simd_for(periods, size, [=](const int idx) {
+        roc_ptr[idx] = ((prices_ptr[idx] - prices_ptr[idx-periods]) 
+                / prices_ptr[idx-periods]) * 100.0;
+    });
+}
+
+/*
+*   Implementation of VPT.
+*
+*   Math: (((close - close_yesterday) / (close_yesterday)) * volume) + pvt_yesterday
+*   @param prices (vector<double>): Vector with closing prices.
+*   @param volumes (vector<double>): Vector with volume prices.
+ */
+template <typename T>
+void vpt_kernel(const T *prices_ptr, const T *volumes_ptr, T *vpt_ptr,
+        const int size) {
+
+    if (size == 0) {
+        return;
+    }
+
+    // Need a first value for the vpt. The rest is an additive scan, see
+    // scan.h.
+    prefix_scan<AdditiveScan>(vpt_ptr, size, volumes_ptr[0], [=](const int idx) -> T {
+        return ((prices_ptr[idx] - prices_ptr[idx-1]) / 
+                    prices_ptr[idx-1]) * volumes_ptr[idx];
+    });
+}
+
+/*
+*   Implementation of MI.
+*
+*   Math: close - close_periods
+*   @param prices (vector<double>): Vector with closing prices.
+*   @param periods (int): Number of periods.
+*/
+template <typename T>
+void mi_kernel(const T *prices_ptr, T *momentum_ptr, const int size,
+        const int periods) {
+
+    if (periods < 1) {
+        init_nan(momentum_ptr, size);
+        return;
+    }
+
+    init_nan(momentum_ptr, std::min(size, periods));
+
+    simd_for(periods, size, [=](const int idx) {
+        momentum_ptr[idx] = prices_ptr[idx] - prices_ptr[idx-periods];
+    });
+}
+
+/*
+ *   Implementation of CCI.
+ *
+ *   Math: CCI = (TP - TP_sma) / (0.015 - MD).
+ *      TP = Typical price = (high + low + close) / 3;
+ *      MD = Mean deviation, calcualted with:
+ *          sum of the absolute values between recent tp_sma and all 
+ *          tp for the lookback period.
+ *          Finally, MD = sum / period.
+ *
+ *   @param close (vector<double>): Vector with closing prices.
+ *   @param high (vector<double>): Vector with high prices.
+ *   @param low (vector<double>): Vector with low prices.
+ *   @param period (int): Number of periods.
+ *   @return: Vector with cci-values.
+ */
+template <typename T>
+void cci_kernel(const T *close_ptr, const T *high_ptr, const T *low_ptr,
+        T *cci_ptr, const int size, const int period) {
+
+    if (period < 1) {
+        init_nan(cci_ptr, size);
+        return;
+    }
+
+    init_nan(cci_ptr, std::min(size, period - 1));
+
+    std::vector<T> tp(size);
+    T *tp_ptr = tp.data();
+    simd_for(0, size, [=](const int idx) {
+        tp_ptr[idx] = (close_ptr[idx] + high_ptr[idx] + low_ptr[idx]) / 3.0;
+    });
+
+    std::vector<T> tpsma(size);
+    sma_kernel(tp.data(), tpsma.data(), size, period);
+
+    const T constant = 0.015;
+
+    for (int idx = period-1; idx < size; ++idx) {
+        // Mean deviation
+        T mean_dev = 0.0;
+        for (int idx1 = idx-period+1; idx1 <= idx; ++idx1) {
+            mean_dev += abs(tpsma[idx] - tp[idx1]);
+        }
+
+        mean_dev /= period;
+        cci_ptr[idx] = (tp[idx] - tpsma[idx]) / (constant * mean_dev);
+    }
+}
+
+/*
+ *   Implementation of AROON.
+ *
+ *   @param high (vector<double>): Vector with high prices.
+ *   @param low (vector<double>): Vector with low prices.
+ *   @param period (int): Number of periods.
+ *   @return: Tuple with aroon-os, aroon-up, aroon-down.
+ */
+template <typename T>
+void aroon_kernel(const T *high_ptr, const T *low_ptr, T *aroon_ptr,
+        const int size, const int period) {
+
+    if (period < 0) {
+        init_nan(aroon_ptr, size);
+        return;
+    }
+
+    init_nan(aroon_ptr, std::min(size, period));
+
+    // The window includes the current bar and the period bars before it.
+    RollingMax<T> highest(high_ptr, period + 1);
+    RollingMin<T> lowest(low_ptr, period + 1);
+    
+    for (int idx = 0; idx < size; ++idx) {
+        highest.push(idx);
+        lowest.push(idx);
+
+        if (idx < period) {
+            continue;
+        }
+
+        if (highest.has_nan(idx) || lowest.has_nan(idx)) {
+            aroon_ptr[idx] = std::numeric_limits<T>::quiet_NaN();
+            continue;
+        }
+
+        int days_up = idx - highest.front();
+        int days_down = idx - lowest.front();
+
+        T aroon_up = ((T)(period - days_up) / period) * 100;
+        T aroon_down = ((T)(period - days_down) / period) * 100;
+        aroon_ptr[idx] = aroon_up - aroon_down;
+    }
+}
+
+/*
+ *   Implementation of APO.
+ *
+ *   Math: MA(period_fast) - MA(period_slow), where:
+ *   MA can be specified as:
+ *      SMA
+ *      EMA
+ *
+ *   @param price (const T *): Array with prices.
+ *   @param period_slow (int): Slow period.
+ *   @param period_fast (int): Fast period.
+ *   MA (SmaPolicy/EmaPolicy): Moving average, see _trend.h.
+ *
+ */
+template <typename T, typename MA>
+void apo_kernel(const T *prices_ptr, T *apo_ptr, const int size,
+        const int period_slow, const int period_fast) {
+
+    if (period_slow < 1 || period_fast < 1) {
+        init_nan(apo_ptr, size);
+        return;
+    }
+
+    std::vector<T> ma_fast(size);
+    std::vector<T> ma_slow(size);
+    
+    MA::kernel(prices_ptr, ma_fast.data(), size, period_fast);
+    MA::kernel(prices_ptr, ma_slow.data(), size, period_slow);
+
+    init_nan(apo_ptr, std::min(size, period_slow - 1));
+
+    for (int idx = period_slow-1; idx < size; ++idx) {
+        apo_ptr[idx] = ma_fast[idx] - ma_slow[idx];
+    }
+}
+
+/*
+ *   Implementation of BPO.
+ *
+ *   Math: (close - open) / (high - low);
+ *
+ *   @param close (const T *): Array with close prices.
+ *   @param open (const T *): Array with opening prices.
+ *   @param high (const T *): Array with high prices.
+ *   @param low (const T *): Array with low prices.
+ *
+ */
+template <typename T>
+void bop_kernel(const T *high_ptr, const T *low_ptr, const T *open_ptr,
+        const T *close_ptr, T *bop_ptr, const int size) {
+    
+    // The division is done for every bar and overwritten where the range is
+    // zero, which the compiler can vectorize unlike a branch around it.
+    simd_for(0, size, [=](const int idx) {
+        T numerator = high_ptr[idx] - low_ptr[idx];
+        bop_ptr[idx] = (close_ptr[idx] - open_ptr[idx]) / numerator;
+
+        if (!(numerator > 0)) {
+            bop_ptr[idx] = 0.0;
+        }
+    });
+}
+
+/*
+ *   Implementation of CMO.
+ *
+ *   Math: ((sum_up - sum_down) / (sum_up + sum_down)) * 100, where:
+ *      sum_up is the sum of the difference between current close and 
+ *      previous close on up days during the period.
+ *      sum_down is the sum of the difference between current close and
+ *      previous close on down days during the period.
+ *
+ *   @param close (const T *): Array with close prices.
+ *   @param period (int): Number of periods.
+ */
+template <typename T>
+void cmo_kernel(const T *close_ptr, T *cmo_ptr, const int size, const int period) {
+    if (period < 1) {
+        init_nan(cmo_ptr, size);
+        return;
+    }
+
+    init_nan(cmo_ptr, std::min(size, period));
+
+    std::vector<T> diff_up(size, 0.0);
+    std::vector<T> diff_down(size, 0.0);
+    
+    T cmo_down = 0.0;
+    T cmo_up = 0.0;
+
+    for (int idx = 1; idx < size; ++idx) {
+        // Create the diff arrays.
+        T diff = close_ptr[idx] - close_ptr[idx-1];
+        if (diff > 0.0) {
+            diff_up[idx] = diff;
+        }
+
+        else if (diff < 0.0) {
+            diff_down[idx] = diff * -1.0;
+        }
+        
+        // Increment cmo_up/cmo_down witht he differences. In case the stock rose one day,
+        // the down diff will be zero, so both variables can be incremented at the same time.
+        cmo_up += diff_up[idx];
+        cmo_down += diff_down[idx];
+
+        // Remove first value in each new period.
+        if (idx > period) {
+            cmo_down -= diff_down[idx-period];
+            cmo_up -= diff_up[idx-period];
+        }
+        
+        if (idx >= period) {
+            cmo_ptr[idx] = ((cmo_up - cmo_down) / (cmo_up + cmo_down)) * 100;
+        }
+    }
+}
+
+/*
+ *   Implementation of MFI.
+ *  
+ *   Math: Typical price: (high + low + close) / 3.
+ *      Raw money flow: Typical price * volume.
+ *      Money flow ratio = x_period positive raw money flow / x_period negative raw money flow.
+ *      positive/negative flow is calculated as the sum of the typical prices when today's
+ *      typical price is higher/lower that the previous.
+ *      Money flow index = 100 - (100 / (1 - money flow ratio)).
+ *
+ *   @param high (const T *): Array with high prices.
+ *   @param low (const T *): Array with low prices.
+ *   @param close (const T *): Array with close prices.
+ *   @param volume (const T *): Array with volume prices.
+ *   @param period (int): Number of periods.
+ */
+template <typename T>
+void mfi_kernel(const T *high_ptr, const T *low_ptr, const T *close_ptr,
+        const T *volume_ptr, T *mfi_ptr, const int size, const int period) {
+
+    if (period < 1) {
+        init_nan(mfi_ptr, size);
+        return;
+    }
+
+    init_nan(mfi_ptr, std::min(size, period));
+
+    std::vector<T> raw_down(size, 0.0);
+    std::vector<T> raw_up(size, 0.0);
+    
+    T raw_up_sum = 0.0;
+    T raw_down_sum = 0.0;
+    for (int idx = 1; idx < size; ++idx) {
+        T tp = (T)(high_ptr[idx] + low_ptr[idx] + close_ptr[idx]) / 3;
+        T tp_prior = (T)(high_ptr[idx-1] + low_ptr[idx-1] + close_ptr[idx-1]) / 3;
+        
+        // Increase the raw money flow. Save raw up/down since we need to remove these values
+        // later on, when a new period stats.
+        if (tp > tp_prior) {
+            raw_up[idx] = tp * volume_ptr[idx];
+            raw_up_sum += raw_up[idx];
+        }
+
+        else if (tp < tp_prior) {
+            raw_down[idx] = tp * volume_ptr[idx];
+            raw_down_sum += raw_down[idx];
+        }
+        
+        // When a new period starts, remove first raw values since it doesn't belong
+        // to this periods calculation.
+        if (idx > period) {
+            raw_up_sum -= raw_up[idx-period];
+            raw_down_sum -= raw_down[idx-period];
+        }
+
+        // Calculate the MFI
+        if (idx >= period) {
+            T mfr = raw_up_sum / raw_down_sum;
+            if (raw_down_sum != 0) {
+                mfi_ptr[idx] = 100 - ((T)100 / (1 + mfr));
+            }
+
+            else {
+                mfi_ptr[idx] = std::numeric_limits<T>::quiet_NaN();
+            }
+        }
+
+    }
+}
+
+/*
+*   Implementation of PPO.
+*
+*   @param prices (vector<double>): Vector with prices.
+*   @param default_size (bool): Specify whether returned vector should be same length
+*       filled with NaNs.
+*/
+template <typename T, typename MA>
+void ppo_kernel(const T *prices_ptr, T *ppo_ptr, const int size,
+        const int period_fast, const int period_slow) {
+    
+    init_nan(ppo_ptr, std::min(size, 25));
+
+    std::vector<T> ma_fast(size);
+    std::vector<T> ma_slow(size);
+    
+    MA::kernel(prices_ptr, ma_fast.data(), size, period_fast);
+    MA::kernel(prices_ptr, ma_slow.data(), size, period_slow);
+    
+    for (int idx = 25; idx < size; ++idx) {
+        ppo_ptr[idx] = ((ma_fast[idx] - ma_slow[idx]) / ma_slow[idx]) * 100;
+    }
+}
+
+#endif
@@ -0,0 +1,417 @@
+#ifndef CORE_PATTERNS_H
+#define CORE_PATTERNS_H
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+#include "util.h"
+#include "trend.h"
+#include "candlestick.h"
+#include "conditions.h"
+
+/*
+ *  Candlestick patterns, kernels working on a single series of size bars
+ *  (see trend.h). The output is true for the bars where the pattern is
+ *  found, and false for the bars before it can be found.
+ */
+
+// Period of the ema of the body sizes, that short and long bodies are
+// compared with.
+#define BODY_AVG_PERIOD 14
+
+/*
+ *  Utility function to get the averages of candlestick
+ *  body sizes.
+ */
+template <typename T>
+std::vector<T> get_body_avg(const T *open_ptr, const T *close_ptr, const int size,
+        const int period) {
+
+    std::vector<T> bodies(size);
+    for (int idx = 0; idx < size; ++idx) {
+        bodies[idx] = std::abs(close_ptr[idx] - open_ptr[idx]);
+    }
+
+    std::vector<T> body_avg(size);
+    ema_kernel(bodies.data(), body_avg.data(), size, period);
+    return body_avg;
+ }
+
+/*
+ * Utility function to get trend using a moving average, MA being one of the
+ * policies in trend.h.
+ */
+template <typename MA, typename T>
+std::vector<T> get_trend(const T *close_ptr, const int size, const int trend_period) {
+    std::vector<T> ma(size);
+    MA::kernel(close_ptr, ma.data(), size, trend_period);
+    return ma;
+}
+
+/*
+ *  Candlesticks of a series of bars, with the body average and the trend
+ *  of every bar.
+ */
+template <typename T>
+struct CandleSeries {
+    const T *high;
+    const T *low;
+    const T *open;
+    const T *close;
+    std::vector<T> body_avg;
+    std::vector<T> trend;
+
+    CandleSeries(const T *high, const T *low, const T *open, const T *close,
+            const int size, const int trend_period) {
+        this -> high = high;
+        this -> low = low;
+        this -> open = open;
+        this -> close = close;
+        trend = get_trend<SmaPolicy>(close, size, trend_period);
+        body_avg = get_body_avg(open, close, size, BODY_AVG_PERIOD);
+    }
+
+    Candlestick<T> operator[](const int idx) const {
+        return {high[idx], low[idx], open[idx], close[idx], body_avg[idx], trend[idx]};
+    }
+};
+
+/*
+ *  Implementation of HAMMER.
+ *
+ *  Params:
+ *      high_ptr (T*) : High prices.
+ *      low_ptr (T*) : Low prices.
+ *      open_ptr (T*) : Opening prices.
+ *      close_ptr (T*) : Close prices.
+ *      trend_period (int) : Specify the period for identify trend.
+ *      type (HammerType) : Hammer or inverted hammer.
+ *      shadow_marign (T) : How much margin should be allowed on the 
+ *          upper shadow.
+ *      pattern_ptr (bool*) : Output, true where the pattern is found.
+ *      size (int) : Number of bars.
+ */
+template <typename T, HammerType type>
+void hammer_kernel(const T *high_ptr, const T *low_ptr, const T *open_ptr,
+        const T *close_ptr, bool *pattern_ptr, const int size, const int trend_period,
+        const T shadow_margin) {
+
+    const CandleSeries<T> candles(high_ptr, low_ptr, open_ptr, close_ptr, size, trend_period);
+    init_false(pattern_ptr, std::min(size, BODY_AVG_PERIOD));
+
+    for (int idx = BODY_AVG_PERIOD; idx < size; ++idx) {
+        pattern_ptr[idx] = hammer_conditions<type>(candles[idx], shadow_margin);
+    }
+}
+
+/*
+ *  Implementation of DOJI.
+ *  
+ *  Params:
+ *      high_ptr (T*) : High prices.
+ *      low_ptr (T*) : Low prices.
+ *      open_ptr (T*) : Opening prices.
+ *      close_ptr (T*) : Close prices.
+ *      trend_period (int) : Specify the period for identify trend.
+ *      pattern_ptr (bool*) : Output, true where the pattern is found.
+ *      size (int) : Number of bars.
+ */
+template <typename T>
+void doji_kernel(const T *high_ptr, const T *low_ptr, const T *open_ptr,
+        const T *close_ptr, bool *pattern_ptr, const int size, const int trend_period) {
+
+    const CandleSeries<T> candles(high_ptr, low_ptr, open_ptr, close_ptr, size, trend_period);
+    init_false(pattern_ptr, std::min(size, BODY_AVG_PERIOD));
+
+    for (int idx = BODY_AVG_PERIOD; idx < size; ++idx) {
+        pattern_ptr[idx] = doji_conditions(candles[idx]);
+    }
+}
+
+/*
+ *  Implementation of DRAGONFLY_DOJI.
+ *  
+ *  Params:
+ *      high_ptr (T*) : High prices.
+ *      low_ptr (T*) : Low prices.
+ *      open_ptr (T*) : Opening prices.
+ *      close_ptr (T*) : Close prices.
+ *      trend_period (int) : Specify the period for identify trend.
+ *      pattern_ptr (bool*) : Output, true where the pattern is found.
+ *      size (int) : Number of bars.
+ */
+template <typename T>
+void dragonfly_doji_kernel(const T *high_ptr, const T *low_ptr, const T *open_ptr,
+        const T *close_ptr, bool *pattern_ptr, const int size, const int trend_period) {
+
+    const CandleSeries<T> candles(high_ptr, low_ptr, open_ptr, close_ptr, size, trend_period);
+    init_false(pattern_ptr, std::min(size, BODY_AVG_PERIOD));
+
+    for (int idx = BODY_AVG_PERIOD; idx < size; ++idx) {
+        pattern_ptr[idx] = dragonfly_doji_conditions(candles[idx]);
+    }
+}
+
+/*
+ *  Implementation of MARUBOZU_WHITE.
+ *  
+ *  Params:
+ *      high_ptr (T*) : High prices.
+ *      low_ptr (T*) : Low prices.
+ *      open_ptr (T*) : Opening prices.
+ *      close_ptr (T*) : Close prices.
+ *      shadow_margin (float) : Float specifying what margin should be allowed
+ *          for the shadows. For example, by using shadow_marign = 5, one allows
+ *          the upper/lower shadows to be as high as 5% of the body size.
+ *      trend_period (int) : Specify the period for identify trend.
+ *      pattern_ptr (bool*) : Output, true where the pattern is found.
+ *      size (int) : Number of bars.
+ */
+template <typename T>
+void marubozu_white_kernel(const T *high_ptr, const T *low_ptr, const T *open_ptr,
+        const T *close_ptr, bool *pattern_ptr, const int size, const int trend_period,
+        const T shadow_margin) {
+
+    const CandleSeries<T> candles(high_ptr, low_ptr, open_ptr, close_ptr, size, trend_period);
+    init_false(pattern_ptr, std::min(size, BODY_AVG_PERIOD));
+
+    for (int idx = BODY_AVG_PERIOD; idx < size; ++idx) {
+        pattern_ptr[idx] = marubozu_white_conditions(candles[idx], shadow_margin);
+    }
+}
+
+/*
+ *  Implementation of MARUBOZU_BLACK.
+ *  
+ *  Params:
+ *      high_ptr (T*) : High prices.
+ *      low_ptr (T*) : Low prices.
+ *      open_ptr (T*) : Opening prices.
+ *      close_ptr (T*) : Close prices.
+ *      shadow_margin (float) : Float specifying what margin should be allowed
+ *          for the shadows. For example, by using shadow_marign = 5, one allows
+ *          the upper/lower shadows to be as high as 5% of the body size.
+ *      trend_period (int) : Specify the period for identify trend.
+ *      pattern_ptr (bool*) : Output, true where the pattern is found.
+ *      size (int) : Number of bars.
+ */
+template <typename T>
+void marubozu_black_kernel(const T *high_ptr, const T *low_ptr, const T *open_ptr,
+        const T *close_ptr, bool *pattern_ptr, const int size, const int trend_period,
+        const T shadow_margin) {
+
+    const CandleSeries<T> candles(high_ptr, low_ptr, open_ptr, close_ptr, size, trend_period);
+    init_false(pattern_ptr, std::min(size, BODY_AVG_PERIOD));
+
+    for (int idx = BODY_AVG_PERIOD; idx < size; ++idx) {
+        pattern_ptr[idx] = marubozu_black_conditions(candles[idx], shadow_margin);
+    }
+}
+
+/*
+ *  Implementation of SPINNING_TOP_WHITE.
+ *  
+ *  Params:
+ *      high_ptr (T*) : High prices.
+ *      low_ptr (T*) : Low prices.
+ *      open_ptr (T*) : Opening prices.
+ *      close_ptr (T*) : Close prices.
+ *      trend_period (int) : Specify the period for identify trend.
+ *      pattern_ptr (bool*) : Output, true where the pattern is found.
+ *      size (int) : Number of bars.
+ */
+template <typename T>
+void spinning_top_white_kernel(const T *high_ptr, const T *low_ptr, const T *open_ptr,
+        const T *close_ptr, bool *pattern_ptr, const int size, const int trend_period) {
+
+    const CandleSeries<T> candles(high_ptr, low_ptr, open_ptr, close_ptr, size, trend_period);
+    init_false(pattern_ptr, std::min(size, BODY_AVG_PERIOD));
+
+    for (int idx = BODY_AVG_PERIOD; idx < size; ++idx) {
+        pattern_ptr[idx] = spinning_top_white_conditions(candles[idx]);
+    }
+}
+
+/*
+ *  Implementation of ENGULFING.
+ *  
+ *  Params:
+ *      high_ptr (T*) : High prices.
+ *      low_ptr (T*) : Low prices.
+ *      open_ptr (T*) : Opening prices.
+ *      close_ptr (T*) : Close prices.
+ *      trend_period (int) : Period for moving average in order to identify trend.
+ *      type (Direction) : Specify what kind of engulfing type that should
+ *          be calculated. Bull or bear.
+ *      pattern_ptr (bool*) : Output, true where the pattern is found.
+ *      size (int) : Number of bars.
+ */
+template <typename T, Direction type>
+void engulfing_kernel(const T *high_ptr, const T *low_ptr, const T *open_ptr,
+        const T *close_ptr, bool *pattern_ptr, const int size, const int trend_period) {
+
+    const CandleSeries<T> candles(high_ptr, low_ptr, open_ptr, close_ptr, size, trend_period);
+    init_false(pattern_ptr, std::min(size, BODY_AVG_PERIOD + 1));
+
+    for (int idx = BODY_AVG_PERIOD + 1; idx < size; ++idx) {
+        pattern_ptr[idx] = engulfing_conditions<type>(candles[idx], candles[idx-1]);
+    }
+}
+
+/*
+ *  Implementation of HARAMI.
+ *  
+ *  Params:
+ *      high_ptr (T*) : High prices.
+ *      low_ptr (T*) : Low prices.
+ *      open_ptr (T*) : Opening prices.
+ *      close_ptr (T*) : Close prices.
+ *      trend_period (int) : Period for moving average in order to identify trend.
+ *      type (Direction) : Specify what kind of harami type that should
+ *          be calculated. Bull or bear.
+ *      pattern_ptr (bool*) : Output, true where the pattern is found.
+ *      size (int) : Number of bars.
+ */
+template <typename T, Direction type>
+void harami_kernel(const T *high_ptr, const T *low_ptr, const T *open_ptr,
+        const T *close_ptr, bool *pattern_ptr, const int size, const int trend_period) {
+
+    const CandleSeries<T> candles(high_ptr, low_ptr, open_ptr, close_ptr, size, trend_period);
+    init_false(pattern_ptr, std::min(size, BODY_AVG_PERIOD + 1));
+
+    for (int idx = BODY_AVG_PERIOD + 1; idx < size; ++idx) {
+        pattern_ptr[idx] = harami_conditions<type>(candles[idx], candles[idx-1]);
+    }
+}
+
+/*
+ *  Implementation of KICKING.
+ *   
+ *  Params:
+ *      high_ptr (T*) : High prices.
+ *      low_ptr (T*) : Low prices.
+ *      open_ptr (T*) : Opening prices.
+ *      close_ptr (T*) : Close prices.
+ *      trend_period (int) : Period for moving average in order to identify trend.
+ *      type (Direction) : Specify what kind of kicking type that should
+ *          be calculated. Bull or bear.
+ *      shadow_margin (float) : Float specifying what margin should be allowed
+ *          for the shadows. For example, by using shadow_marign = 5, one allows
+ *          the upper/lower shadows to be as long as 5% of the body size.
+ *      pattern_ptr (bool*) : Output, true where the pattern is found.
+ *      size (int) : Number of bars.
+ */
+template <typename T, Direction type>
+void kicking_kernel(const T *high_ptr, const T *low_ptr, const T *open_ptr,
+        const T *close_ptr, bool *pattern_ptr, const int size, const int trend_period,
+        const float shadow_margin) {
+
+    const CandleSeries<T> candles(high_ptr, low_ptr, open_ptr, close_ptr, size, trend_period);
+    init_false(pattern_ptr, std::min(size, BODY_AVG_PERIOD + 1));
+
+    for (int idx = BODY_AVG_PERIOD + 1; idx < size; ++idx) {
+        pattern_ptr[idx] = kicking_conditions<type>(candles[idx], candles[idx-1],
+                shadow_margin);
+    }
+}
+
+/*
+ *  Implementation of PIERCING.
+ *  
+ *  Params:
+ *      high_ptr (T*) : High prices.
+ *      low_ptr (T*) : Low prices.
+ *      open_ptr (T*) : Opening prices.
+ *      close_ptr (T*) : Close prices.
+ *      trend_period (int) : Period for moving average in order to identify trend.
+ *      pattern_ptr (bool*) : Output, true where the pattern is found.
+ *      size (int) : Number of bars.
+ */
+template <typename T>
+void piercing_kernel(const T *high_ptr, const T *low_ptr, const T *open_ptr,
+        const T *close_ptr, bool *pattern_ptr, const int size, const int trend_period) {
+
+    const CandleSeries<T> candles(high_ptr, low_ptr, open_ptr, close_ptr, size, trend_period);
+    init_false(pattern_ptr, std::min(size, BODY_AVG_PERIOD + 1));
+
+    for (int idx = BODY_AVG_PERIOD + 1; idx < size; ++idx) {
+        pattern_ptr[idx] = piercing_conditions(candles[idx], candles[idx-1]);
+    }
+}
+
+/*
+ *  Implementation of THREE WHITE SOLDIERS.
+ *  
+ *  Params:
+ *      high_ptr (T*) : High prices.
+ *      low_ptr (T*) : Low prices.
+ *      open_ptr (T*) : Opening prices.
+ *      close_ptr (T*) : Close prices.
+ *      trend_period (int) : Period for moving average in order to identify trend.
+ *      pattern_ptr (bool*) : Output, true where the pattern is found.
+ *      size (int) : Number of bars.
+ */
+template <typename T>
+void tws_kernel(const T *high_ptr, const T *low_ptr, const T *open_ptr,
+        const T *close_ptr, bool *pattern_ptr, const int size, const int trend_period) {
+
+    const CandleSeries<T> candles(high_ptr, low_ptr, open_ptr, close_ptr, size, trend_period);
+    init_false(pattern_ptr, std::min(size, BODY_AVG_PERIOD + 2));
+
+    for (int idx = BODY_AVG_PERIOD + 2; idx < size; ++idx) {
+        pattern_ptr[idx] = tws_conditions(candles[idx], candles[idx-1], candles[idx-2]);
+    }
+}
+
+/*
+ *  Implementation of ABANDONED BABY.
+ *  
+ *  Params:
+ *      high_ptr (T*) : High prices.
+ *      low_ptr (T*) : Low prices.
+ *      open_ptr (T*) : Opening prices.
+ *      close_ptr (T*) : Close prices.
+ *      trend_period (int) : Period for moving average in order to identify trend.
+ *      pattern_ptr (bool*) : Output, true where the pattern is found.
+ *      size (int) : Number of bars.
+ */
+template <typename T, Direction type>
+void abandoned_baby_kernel(const T *high_ptr, const T *low_ptr, const T *open_ptr,
+        const T *close_ptr, bool *pattern_ptr, const int size, const int trend_period) {
+
+    const CandleSeries<T> candles(high_ptr, low_ptr, open_ptr, close_ptr, size, trend_period);
+    init_false(pattern_ptr, std::min(size, BODY_AVG_PERIOD + 2));
+
+    for (int idx = BODY_AVG_PERIOD + 2; idx < size; ++idx) {
+        pattern_ptr[idx] = abandoned_baby_conditions<type>(candles[idx], candles[idx-1],
+                candles[idx-2]);
+    }
+}
+
+/*
+ *  Implementation of Belt Hold.
+ *  
+ *  Params:
+ *      high_ptr (T*) : High prices.
+ *      low_ptr (T*) : Low prices.
+ *      open_ptr (T*) : Opening prices.
+ *      close_ptr (T*) : Close prices.
+ *      trend_period (int) : Period for moving average in order to identify trend.
+ *      pattern_ptr (bool*) : Output, true where the pattern is found.
+ *      size (int) : Number of bars.
+ */
+template <typename T, Direction type>
+void belthold_kernel(const T *high_ptr, const T *low_ptr, const T *open_ptr,
+        const T *close_ptr, bool *pattern_ptr, const int size, const int trend_period,
+        const float shadow_margin) {
+
+    const CandleSeries<T> candles(high_ptr, low_ptr, open_ptr, close_ptr, size, trend_period);
+    init_false(pattern_ptr, std::min(size, BODY_AVG_PERIOD));
+
+    for (int idx = BODY_AVG_PERIOD; idx < size; ++idx) {
+        pattern_ptr[idx] = belthold_conditions<type>(candles[idx], shadow_margin);
+    }
+}
+
+#endif
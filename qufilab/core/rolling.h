@@ -0,0 +1,455 @@
+#ifndef INDICATOR_ROLLING_H
+#define INDICATOR_ROLLING_H
+
+#include <vector>
+#include <functional>
+#include <limits>
+#include <cmath>
+#include <algorithm>
+
+/*
+ *  Position of the maximum (Compare = std::greater<T>) or minimum
+ *  (Compare = std::less<T>) in a sliding window of period values.
+ *
+ *  The indices in the window are kept in a monotonic deque, i.e. ordered by
+ *  index with the values ordered by Compare, so the extremum is always at the
+ *  front. Each index is pushed and popped once, which makes the cost per bar
+ *  amortized O(1) instead of O(period). Of equal values the earliest is
+ *  kept, the same as std::max_element/std::min_element.
+ *
+ *  NaN values are not pushed, a window containing NaN is reported by has_nan
+ *  instead.
+ */
+template <typename T, typename Compare>
+class MonotonicWindow {
+    public:
+        MonotonicWindow(const T *values_ptr, const int period) :
+            values_ptr(values_ptr), period(period), indices(period),
+            head(0), count(0), last_nan(-period) {}
+
+        // Add values_ptr[idx], where idx is one more than the previous index.
+        void push(const int idx) {
+            if (count > 0 && indices[head] <= idx - period) {
+                head = head + 1 == period ? 0 : head + 1;
+                --count;
+            }
+
+            const T value = values_ptr[idx];
+
+            if (value != value) {
+                last_nan = idx;
+                return;
+            }
+
+            while (count > 0 && Compare()(value, values_ptr[back()])) {
+                --count;
+            }
+
+            int tail = head + count;
+            indices[tail >= period ? tail - period : tail] = idx;
+            ++count;
+        }
+
+        // Index of the extremum in the window ending at idx, the last index
+        // pushed. Only valid if the window doesn't contain NaN.
+        int front() const {
+            return indices[head];
+        }
+
+        bool has_nan(const int idx) const {
+            return idx - last_nan < period;
+        }
+
+    private:
+        int back() const {
+            int tail = head + count - 1;
+            return indices[tail >= period ? tail - period : tail];
+        }
+
+        const T *values_ptr;
+        int period;
+        std::vector<int> indices;
+        int head;
+        int count;
+        int last_nan;
+};
+
+template <typename T>
+using RollingMax = MonotonicWindow<T, std::greater<T>>;
+
+template <typename T>
+using RollingMin = MonotonicWindow<T, std::less<T>>;
+
+/*
+ *  Series for CoMomentWindow, the values themselves or their percentage
+ *  change from the previous value (NaN for the first value).
+ */
+template <typename T>
+struct ValueSeries {
+    const T *ptr;
+
+    double operator()(const int idx) const {
+        return ptr[idx];
+    }
+};
+
+template <typename T>
+struct PctChangeSeries {
+    const T *ptr;
+
+    double operator()(const int idx) const {
+        if (idx == 0) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+
+        return ((ptr[idx] - ptr[idx-1]) / ptr[idx-1]) * 100;
+    }
+};
+
+/*
+ *  Mean and sum of squared deviations (m2) of a series over a sliding
+ *  window of period values.
+ *
+ *  Once the window is full, every push replaces the oldest value by the new
+ *  one with Welford's updates, in constant time. Every period pushes m2 is
+ *  recalculated from the window instead, so the rounding errors of the
+ *  updates don't add up over long series. The values are kept relative to
+ *  a recent value (shift), so the rounding is relative to the range of the
+ *  window rather than the level of the values.
+ *
+ *  A NaN empties the window, so windows containing NaN are never full.
+ */
+template <typename Series>
+class MomentWindow {
+    public:
+        MomentWindow(const Series x, const int period) :
+            x(x), period(period), count(0), updates(0), shift(0.0), mean_(0.0),
+            m2_(0.0) {}
+
+        // Add the value at idx, where idx is one more than the previous
+        // index. Returns whether the window ending at idx is full.
+        bool push(const int idx) {
+            const double x_in = x(idx);
+
+            if (std::isnan(x_in)) {
+                count = 0;
+                return false;
+            }
+
+            if (count == 0) {
+                shift = x_in;
+                mean_ = 0.0;
+                m2_ = 0.0;
+            }
+
+            const double value = x_in - shift;
+
+            if (count < period) {
+                ++count;
+                const double delta = value - mean_;
+                mean_ += delta / count;
+                m2_ += delta * (value - mean_);
+                updates = 0;
+            }
+
+            else if (++updates < period) {
+                const double value_out = x(idx - period) - shift;
+                const double mean_prev = mean_;
+                mean_ += (value - value_out) / period;
+                m2_ += (value - value_out) * (value - mean_ + value_out - mean_prev);
+                m2_ = std::max(m2_, 0.0);
+            }
+
+            else {
+                shift = x_in;
+
+                double sum = 0.0;
+                for (int idx1 = idx - period + 1; idx1 <= idx; ++idx1) {
+                    sum += x(idx1) - shift;
+                }
+                mean_ = sum / period;
+
+                m2_ = 0.0;
+                for (int idx1 = idx - period + 1; idx1 <= idx; ++idx1) {
+                    const double deviation = (x(idx1) - shift) - mean_;
+                    m2_ += deviation * deviation;
+                }
+                updates = 0;
+            }
+
+            return count == period;
+        }
+
+        double mean() const {
+            return shift + mean_;
+        }
+
+        double m2() const {
+            return m2_;
+        }
+
+    private:
+        Series x;
+        int period;
+        int count;
+        int updates;
+        double shift;
+        double mean_;
+        double m2_;
+};
+
+/*
+ *  Means, sums of squared deviations (m2) and sum of co-deviations of two
+ *  series over a sliding window of period values.
+ *
+ *  Once the window is full, every push replaces the oldest pair of values by
+ *  the new one with Welford's updates, in constant time. Every period pushes
+ *  the sums are recalculated from the window instead, so the rounding errors
+ *  of the updates don't add up over long series. The values are kept
+ *  relative to a recent value of each series (shift), so the rounding is
+ *  relative to the range of the window rather than the level of the values.
+ *
+ *  A NaN in either series empties the window, so windows containing NaN are
+ *  never full.
+ */
+template <typename Series>
+class CoMomentWindow {
+    public:
+        CoMomentWindow(const Series x, const Series y, const int period) :
+            x(x), y(y), period(period), count(0), updates(0) {
+            reset(0.0, 0.0);
+        }
+
+        // Add the values at idx, where idx is one more than the previous
+        // index. Returns whether the window ending at idx is full.
+        bool push(const int idx) {
+            const double x_in = x(idx);
+            const double y_in = y(idx);
+
+            if (std::isnan(x_in) || std::isnan(y_in)) {
+                count = 0;
+                return false;
+            }
+
+            if (count == 0) {
+                reset(x_in, y_in);
+            }
+
+            const double dx = x_in - shift_x;
+            const double dy = y_in - shift_y;
+
+            if (count < period) {
+                ++count;
+                const double delta_x = dx - mean_x_;
+                const double delta_y = dy - mean_y_;
+                mean_x_ += delta_x / count;
+                mean_y_ += delta_y / count;
+                m2_x_ += delta_x * (dx - mean_x_);
+                m2_y_ += delta_y * (dy - mean_y_);
+                c_xy_ += delta_x * (dy - mean_y_);
+                updates = 0;
+            }
+
+            else if (++updates < period) {
+                const double dx_out = x(idx - period) - shift_x;
+                const double dy_out = y(idx - period) - shift_y;
+                const double mean_x_prev = mean_x_;
+                const double mean_y_prev = mean_y_;
+                mean_x_ += (dx - dx_out) / period;
+                mean_y_ += (dy - dy_out) / period;
+                m2_x_ += (dx - dx_out) * (dx - mean_x_ + dx_out - mean_x_prev);
+                m2_y_ += (dy - dy_out) * (dy - mean_y_ + dy_out - mean_y_prev);
+                c_xy_ += (dx - dx_out) * (dy - mean_y_) + (dy - dy_out) * (dx_out - mean_x_prev);
+                m2_x_ = std::max(m2_x_, 0.0);
+                m2_y_ = std::max(m2_y_, 0.0);
+            }
+
+            else {
+                recalculate(idx);
+            }
+
+            return count == period;
+        }
+
+        double mean_x() const {
+            return shift_x + mean_x_;
+        }
+
+        double mean_y() const {
+            return shift_y + mean_y_;
+        }
+
+        double m2_x() const {
+            return m2_x_;
+        }
+
+        double m2_y() const {
+            return m2_y_;
+        }
+
+        double c_xy() const {
+            return c_xy_;
+        }
+
+    private:
+        void reset(const double x_in, const double y_in) {
+            shift_x = x_in;
+            shift_y = y_in;
+            mean_x_ = 0.0;
+            mean_y_ = 0.0;
+            m2_x_ = 0.0;
+            m2_y_ = 0.0;
+            c_xy_ = 0.0;
+        }
+
+        void recalculate(const int idx) {
+            reset(x(idx), y(idx));
+
+            for (int idx1 = idx - period + 1; idx1 <= idx; ++idx1) {
+                mean_x_ += x(idx1) - shift_x;
+                mean_y_ += y(idx1) - shift_y;
+            }
+            mean_x_ /= period;
+            mean_y_ /= period;
+
+            for (int idx1 = idx - period + 1; idx1 <= idx; ++idx1) {
+                const double deviation_x = (x(idx1) - shift_x) - mean_x_;
+                const double deviation_y = (y(idx1) - shift_y) - mean_y_;
+                m2_x_ += deviation_x * deviation_x;
+                m2_y_ += deviation_y * deviation_y;
+                c_xy_ += deviation_x * deviation_y;
+            }
+            updates = 0;
+        }
+
+        Series x;
+        Series y;
+        int period;
+        int count;
+        int updates;
+        double shift_x;
+        double shift_y;
+        double mean_x_;
+        double mean_y_;
+        double m2_x_;
+        double m2_y_;
+        double c_xy_;
+};
+
+/*
+ *  Rolling mean and m2 of a series that is shared by many calculations,
+ *  e.g. the market when calculating beta for a whole universe of stocks.
+ *  They are calculated once, as the co-moments of the series with itself,
+ *  and are NaN where the window isn't full.
+ */
+struct SharedMoments {
+    template <typename Series>
+    SharedMoments(const Series y, const int size, const int period) :
+        values(size), mean(size), m2(size) {
+
+        const double nan = std::numeric_limits<double>::quiet_NaN();
+        CoMomentWindow<Series> window(y, y, period);
+
+        for (int idx = 0; idx < size; ++idx) {
+            const bool full = window.push(idx);
+            values[idx] = y(idx);
+            mean[idx] = full ? window.mean_y() : nan;
+            m2[idx] = full ? window.m2_y() : nan;
+        }
+    }
+
+    std::vector<double> values;
+    std::vector<double> mean;
+    std::vector<double> m2;
+};
+
+/*
+ *  Same as CoMomentWindow, but with the y side taken from SharedMoments, so
+ *  only the mean and m2 of x and the co-deviation are updated per push. The
+ *  sums are calculated from the window when it has been filled, and then
+ *  updated and recalculated in the same way as CoMomentWindow.
+ */
+template <typename Series>
+class CrossMomentWindow {
+    public:
+        CrossMomentWindow(const Series x, const SharedMoments &shared,
+                const int period) :
+            x(x), y(shared), period(period), count(0), updates(0) {}
+
+        bool push(const int idx) {
+            const double x_in = x(idx);
+            const double y_in = y.values[idx];
+
+            if (std::isnan(x_in) || std::isnan(y_in)) {
+                count = 0;
+                return false;
+            }
+
+            if (count < period) {
+                if (++count == period) {
+                    recalculate(idx);
+                }
+            }
+
+            else if (++updates < period) {
+                const double dx = x_in - shift_x;
+                const double dx_out = x(idx - period) - shift_x;
+                const double y_out = y.values[idx - period];
+                const double mean_x_prev = mean_x_;
+                mean_x_ += (dx - dx_out) / period;
+                m2_x_ += (dx - dx_out) * (dx - mean_x_ + dx_out - mean_x_prev);
+                c_xy_ += (dx - dx_out) * (y_in - y.mean[idx]) + (y_in - y_out) * (dx_out - mean_x_prev);
+                m2_x_ = std::max(m2_x_, 0.0);
+            }
+
+            else {
+                recalculate(idx);
+            }
+
+            return count == period;
+        }
+
+        double mean_x() const {
+            return shift_x + mean_x_;
+        }
+
+        double m2_x() const {
+            return m2_x_;
+        }
+
+        double c_xy() const {
+            return c_xy_;
+        }
+
+    private:
+        void recalculate(const int idx) {
+            shift_x = x(idx);
+            mean_x_ = 0.0;
+            m2_x_ = 0.0;
+            c_xy_ = 0.0;
+
+            for (int idx1 = idx - period + 1; idx1 <= idx; ++idx1) {
+                mean_x_ += x(idx1) - shift_x;
+            }
+            mean_x_ /= period;
+
+            for (int idx1 = idx - period + 1; idx1 <= idx; ++idx1) {
+                const double deviation_x = (x(idx1) - shift_x) - mean_x_;
+                m2_x_ += deviation_x * deviation_x;
+                c_xy_ += deviation_x * (y.values[idx1] - y.mean[idx]);
+            }
+            updates = 0;
+        }
+
+        Series x;
+        const SharedMoments &y;
+        int period;
+        int count;
+        int updates;
+        double shift_x;
+        double mean_x_;
+        double m2_x_;
+        double c_xy_;
+};
+
+#endif
@@ -0,0 +1,258 @@
+#ifndef INDICATOR_SCAN_H
+#define INDICATOR_SCAN_H
+
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+/*
+ *  Prefix scans for the cumulative indicators (acdi, obv, vpt, pvi, nvi).
+ *
+ *  The value at idx is the value at idx - 1 updated with a step that only
+ *  depends on the inputs, either added to it (AdditiveScan) or as a
+ *  relative change of it (RelativeScan, value + step * value). Long series
+ *  are split into blocks of SCAN_BLOCK values that are calculated in
+ *  parallel, each one starting from the identity. The value carried into
+ *  each block is then calculated from the last values of the blocks in
+ *  order, and a fix-up pass combines the values of each block with it.
+ *
+ *  The blocks don't depend on the number of threads, so neither do the
+ *  results. The first block starts from the first value itself, so series
+ *  that fit in a single block give the same values as the serial loop, and
+ *  later blocks only differ by the rounding of the fix-up.
+ *
+ *  Series of a 2D panel are already calculated in parallel by panel_calc,
+ *  and the nested parallel region of the scan runs on a single thread.
+ */
+
+// Number of values per block of the parallel scans.
+#define SCAN_BLOCK 65536
+
+struct AdditiveScan {
+    template <typename T>
+    static T identity() {
+        return 0.0;
+    }
+
+    template <typename T>
+    static T update(const T value, const T step) {
+        return value + step;
+    }
+
+    template <typename T>
+    static T combine(const T carry, const T value) {
+        return carry + value;
+    }
+};
+
+struct RelativeScan {
+    template <typename T>
+    static T identity() {
+        return 1.0;
+    }
+
+    template <typename T>
+    static T update(const T value, const T step) {
+        return value + step * value;
+    }
+
+    template <typename T>
+    static T combine(const T carry, const T value) {
+        return carry * value;
+    }
+};
+
+/*
+ *  Writes first to scan_ptr[0] and Op::update(scan_ptr[idx-1], step(idx))
+ *  to every following value, for size values.
+ */
+template <typename Op, typename T, typename Step>
+void prefix_scan(T *scan_ptr, const int size, const T first, Step step) {
+    if (size < 1) {
+        return;
+    }
+
+    const int n_blocks = (size - 1) / SCAN_BLOCK + 1;
+
+    #pragma omp parallel for schedule(static) if (n_blocks > 1)
+    for (int block = 0; block < n_blocks; ++block) {
+        const int begin = block * SCAN_BLOCK;
+        const int end = std::min(size, begin + SCAN_BLOCK);
+
+        T value = first;
+        if (block > 0) {
+            value = Op::update(Op::template identity<T>(), step(begin));
+        }
+
+        scan_ptr[begin] = value;
+        for (int idx = begin + 1; idx < end; ++idx) {
+            value = Op::update(value, step(idx));
+            scan_ptr[idx] = value;
+        }
+    }
+
+    if (n_blocks == 1) {
+        return;
+    }
+
+    // Value carried into each block, the combined last values of the
+    // blocks before it.
+    std::vector<T> carry(n_blocks);
+    carry[1] = scan_ptr[SCAN_BLOCK - 1];
+    for (int block = 2; block < n_blocks; ++block) {
+        carry[block] = Op::combine(carry[block-1], scan_ptr[block * SCAN_BLOCK - 1]);
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (int block = 1; block < n_blocks; ++block) {
+        const int begin = block * SCAN_BLOCK;
+        const int end = std::min(size, begin + SCAN_BLOCK);
+        const T block_carry = carry[block];
+
+        #pragma omp simd
+        for (int idx = begin; idx < end; ++idx) {
+            scan_ptr[idx] = Op::combine(block_carry, scan_ptr[idx]);
+        }
+    }
+}
+
+/*
+ *  Two recurrences with the same decay that are scanned together, e.g. the
+ *  average gain and loss of the rsi, with the arithmetic affine_scan needs.
+ */
+template <typename T>
+struct ScanPair {
+    T first;
+    T second;
+};
+
+template <typename T>
+inline ScanPair<T> operator+(const ScanPair<T> &a, const ScanPair<T> &b) {
+    return {a.first + b.first, a.second + b.second};
+}
+
+template <typename T>
+inline ScanPair<T> operator*(const T a, const ScanPair<T> &b) {
+    return {a * b.first, a * b.second};
+}
+
+template <typename T>
+inline bool scan_finite(const T value) {
+    return std::isfinite(value);
+}
+
+template <typename T>
+inline bool scan_finite(const ScanPair<T> &value) {
+    return std::isfinite(value.first) && std::isfinite(value.second);
+}
+
+/*
+ *  First order linear recurrences, the smoothing of ema, smma, atr and rsi.
+ *
+ *  Writes first to y_ptr[begin] and update(y_ptr[idx-1], idx) to every
+ *  following value up to end, where update is affine in the previous value
+ *  with slope decay, e.g. (price - prev) * k + prev with decay 1 - k. The
+ *  values are of type T, or ScanPair<T> for two recurrences.
+ *
+ *  Blocked in the same way as prefix_scan. Blocks after the first start
+ *  from zero, so their values are the part of y that comes from the bars
+ *  in the block, and the value carried into the block adds decay^(j + 1)
+ *  times the carry to the j:th value. The powers are tabulated once per
+ *  call, and once they have underflowed the rest of the block doesn't
+ *  change, unless the carry is NaN or infinite.
+ *
+ *  Series that fit in a single block give the same values as the serial
+ *  loop, later values drift from it by a few units in the last place. The
+ *  serial recurrences of the streaming states, the lanes kernels and the
+ *  ema cascades of dema, tema and t3 therefore only match the kernels using
+ *  affine_scan exactly for the first SCAN_BLOCK values.
+ */
+template <typename V, typename T, typename Update>
+void affine_scan(V *y_ptr, const int begin, const int end, const V first,
+        const T decay, Update update) {
+
+    if (end <= begin) {
+        return;
+    }
+
+    const int size = end - begin;
+    const int n_blocks = (size - 1) / SCAN_BLOCK + 1;
+
+    #pragma omp parallel for schedule(static) if (n_blocks > 1)
+    for (int block = 0; block < n_blocks; ++block) {
+        const int block_begin = begin + block * SCAN_BLOCK;
+        const int block_end = std::min(end, block_begin + SCAN_BLOCK);
+
+        V value = first;
+        if (block > 0) {
+            value = update(V(), block_begin);
+        }
+
+        y_ptr[block_begin] = value;
+        for (int idx = block_begin + 1; idx < block_end; ++idx) {
+            value = update(value, idx);
+            y_ptr[idx] = value;
+        }
+    }
+
+    if (n_blocks == 1) {
+        return;
+    }
+
+    // powers[j] = decay^(j + 1), up to the first power that is denormal.
+    // The rest would change the values by less than the smallest normal
+    // number times the carry, and are slow to multiply with.
+    std::vector<T> powers;
+    T power = decay;
+    while ((int) powers.size() < SCAN_BLOCK && power >= std::numeric_limits<T>::min()) {
+        powers.push_back(power);
+        power *= decay;
+    }
+
+    const int n_powers = powers.size();
+
+    // Adds the carry to the j:th value of a block.
+    auto carried = [&](const V value, const int j, const V carry) -> V {
+        if (j < n_powers) {
+            return value + powers[j] * carry;
+        }
+
+        return scan_finite(carry) ? value : value + (T) 0 * carry;
+    };
+
+    // Value carried into each block, the last value of the block before
+    // with its own carry added.
+    std::vector<V> carry(n_blocks);
+    carry[1] = y_ptr[begin + SCAN_BLOCK - 1];
+    for (int block = 2; block < n_blocks; ++block) {
+        carry[block] = carried(y_ptr[begin + block * SCAN_BLOCK - 1], SCAN_BLOCK - 1,
+                carry[block-1]);
+    }
+
+    #pragma omp parallel for schedule(static)
+    for (int block = 1; block < n_blocks; ++block) {
+        const int block_begin = begin + block * SCAN_BLOCK;
+        const int block_size = std::min(end, block_begin + SCAN_BLOCK) - block_begin;
+        const V block_carry = carry[block];
+        V *block_ptr = y_ptr + block_begin;
+
+        if (scan_finite(block_carry)) {
+            const int n_fixed = std::min(block_size, n_powers);
+            const T *powers_ptr = powers.data();
+
+            #pragma omp simd
+            for (int j = 0; j < n_fixed; ++j) {
+                block_ptr[j] = block_ptr[j] + powers_ptr[j] * block_carry;
+            }
+        }
+
+        else {
+            for (int j = 0; j < block_size; ++j) {
+                block_ptr[j] = carried(block_ptr[j], j, block_carry);
+            }
+        }
+    }
+}
+
+#endif
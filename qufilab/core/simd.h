@@ -0,0 +1,168 @@
+#ifndef INDICATOR_SIMD_H
+#define INDICATOR_SIMD_H
+
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <string>
+
+/*
+ *  Runtime selection of SIMD code paths.
+ *
+ *  Kernels with explicit SIMD variants are compiled for every instruction
+ *  set with SIMD_TARGET, independent of the flags the module is compiled
+ *  with, and pick the variant with simd_level() when called. The level is
+ *  the best one the CPU supports, found with CPUID, and can be lowered with
+ *  the environment variable QUFILAB_SIMD ('scalar', 'sse2', 'avx2' or
+ *  'avx512'), e.g. to compare the variants.
+ *
+ *  On other architectures and compilers only the scalar path exists.
+ */
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_X86
+#define SIMD_TARGET(isa) __attribute__((target(isa)))
+#include <immintrin.h>
+#endif
+
+enum class SimdLevel { scalar, sse2, avx2, avx512 };
+
+inline const char *simd_level_name(const SimdLevel level) {
+    switch (level) {
+        case SimdLevel::sse2:
+            return "sse2";
+        case SimdLevel::avx2:
+            return "avx2";
+        case SimdLevel::avx512:
+            return "avx512";
+        default:
+            return "scalar";
+    }
+}
+
+inline SimdLevel simd_detect() {
+#ifdef SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return SimdLevel::avx512;
+    }
+
+    if (__builtin_cpu_supports("avx2")) {
+        return SimdLevel::avx2;
+    }
+
+    if (__builtin_cpu_supports("sse2")) {
+        return SimdLevel::sse2;
+    }
+#endif
+    return SimdLevel::scalar;
+}
+
+inline SimdLevel simd_select() {
+    SimdLevel level = simd_detect();
+
+    const char *requested = std::getenv("QUFILAB_SIMD");
+    if (requested == nullptr) {
+        return level;
+    }
+
+    for (SimdLevel lower : {SimdLevel::scalar, SimdLevel::sse2, SimdLevel::avx2}) {
+        if (std::strcmp(requested, simd_level_name(lower)) == 0 && lower < level) {
+            level = lower;
+        }
+    }
+
+    return level;
+}
+
+// Level used by the kernels, selected once per process.
+inline SimdLevel simd_level() {
+    static const SimdLevel level = simd_select();
+    return level;
+}
+
+/*
+ *  Kernels with SIMD variants and the level each one runs at. Modules call
+ *  simd_register for their kernels when imported, and expose simd_kernels
+ *  to python as _simd_kernels. The modules of the _qufilab extension share
+ *  the registry, so each of them returns all kernels.
+ */
+inline std::map<std::string, std::string> &simd_registry() {
+    static std::map<std::string, std::string> registry;
+    return registry;
+}
+
+inline void simd_register(const std::string &kernel, const SimdLevel level = simd_level()) {
+    simd_registry()[kernel] = simd_level_name(level);
+}
+
+inline std::map<std::string, std::string> simd_kernels() {
+    return simd_registry();
+}
+
+/*
+ *  Elementwise loops, op(idx) for every idx in [begin, end).
+ *
+ *  The loop is compiled once per instruction set and op is inlined into
+ *  each copy, so the compiler vectorizes the same expression with SSE2,
+ *  AVX2 or AVX-512 and simd_for runs the copy for simd_level(). op must
+ *  only write index idx and not depend on earlier iterations. The modules
+ *  are compiled with -ffp-contract=off so that a*b + c isn't fused in the
+ *  AVX2 and AVX-512 copies, and every copy rounds like the scalar loop.
+ */
+template <typename Op>
+inline void simd_for_scalar(const int begin, const int end, Op op) {
+    for (int idx = begin; idx < end; ++idx) {
+        op(idx);
+    }
+}
+
+#ifdef SIMD_X86
+template <typename Op>
+SIMD_TARGET("sse2")
+void simd_for_sse2(const int begin, const int end, Op op) {
+    #pragma omp simd
+    for (int idx = begin; idx < end; ++idx) {
+        op(idx);
+    }
+}
+
+template <typename Op>
+SIMD_TARGET("avx2")
+void simd_for_avx2(const int begin, const int end, Op op) {
+    #pragma omp simd
+    for (int idx = begin; idx < end; ++idx) {
+        op(idx);
+    }
+}
+
+template <typename Op>
+SIMD_TARGET("avx512f")
+void simd_for_avx512(const int begin, const int end, Op op) {
+    #pragma omp simd
+    for (int idx = begin; idx < end; ++idx) {
+        op(idx);
+    }
+}
+#endif
+
+template <typename Op>
+void simd_for(const int begin, const int end, Op op) {
+#ifdef SIMD_X86
+    switch (simd_level()) {
+        case SimdLevel::avx512:
+            simd_for_avx512(begin, end, op);
+            return;
+        case SimdLevel::avx2:
+            simd_for_avx2(begin, end, op);
+            return;
+        case SimdLevel::sse2:
+            simd_for_sse2(begin, end, op);
+            return;
+        default:
+            break;
+    }
+#endif
+    simd_for_scalar(begin, end, op);
+}
+
+#endif
@@ -0,0 +1,670 @@
+#ifndef CORE_STAT_H
+#define CORE_STAT_H
+
+#include <vector>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <functional>
+
+#include "util.h"
+#include "rolling.h"
+#include "simd.h"
+
+/*
+ *  Statistics, kernels working on a single series of size values (see
+ *  trend.h), and on panels of series for the matrices.
+ */
+
+/*
+ * Implementation of VAR.
+ *
+ * Calculates the variance over a sliding window with Welford's updates and
+ * a recalculation every period bars, see MomentWindow in rolling.h, which
+ * costs constant time per bar on average.
+ *
+ * Windows containing NaN give NaN, and the sums start over after a NaN. This
+ * also covers leading NaNs.
+*/
+template <typename T>
+void var_kernel(const T *prices_ptr, T *var_ptr, const int size,
+        const int period, const bool normalize) {
+
+    if (period < 1) {
+        init_nan(var_ptr, size);
+        return;
+    }
+
+    const double divisor = normalize ? period - 1 : period;
+
+    MomentWindow<ValueSeries<T>> window(ValueSeries<T>{prices_ptr}, period);
+
+    for (int idx = 0; idx < size; ++idx) {
+        var_ptr[idx] = window.push(idx) ? window.m2() / divisor : 
+            std::numeric_limits<T>::quiet_NaN();
+    }
+}
+
+/*
+ * Implementation of STD.
+ *
+ * Calculates the standard deviation, the square root of the variance
+ * above. Using normalization by default.
+*/
+
+template <typename T>
+void std_kernel(const T *prices_ptr, T *std_ptr, const int size,
+        const int period, const bool normalize) {
+
+    var_kernel(prices_ptr, std_ptr, size, period, normalize);
+
+    for (int idx = 0; idx < size; ++idx) {
+        std_ptr[idx] = std::sqrt(std_ptr[idx]);
+    }
+}
+
+/*
+ * Implementation of COV, CORR, BETA and ALPHA.
+ *
+ * All four are calculated from the co-moments of the window, see
+ * CoMomentWindow in rolling.h, in a single pass without temporary arrays.
+ * Outputs given as nullptr are skipped.
+ *
+ * @param x (Series): Series that beta and alpha are calculated for.
+ * @param y (Series): Market series that serves as the comparison.
+ * @param normalize (bool): Normalize the covariance with n - 1 instead of n.
+ * @param var_normalize (bool): Normalize the variance of the market within
+ *      beta with n - 1 instead of n, while the covariance is normalized with n.
+ *
+ * Beta is the covariance over the variance of the market, and alpha the
+ * mean of x not explained by beta, mean(x) - beta * mean(y).
+ */
+template <typename T, typename Series>
+void comoment_kernel(const Series x, const Series y, T *cov_ptr, T *corr_ptr,
+        T *beta_ptr, T *alpha_ptr, const int size, const int period,
+        const bool normalize, const bool var_normalize) {
+
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+
+    if (period < 1) {
+        for (T *ptr : {cov_ptr, corr_ptr, beta_ptr, alpha_ptr}) {
+            if (ptr) {
+                init_nan(ptr, size);
+            }
+        }
+        return;
+    }
+
+    const double cov_divisor = normalize ? period - 1 : period;
+    const double var_divisor = var_normalize ? period - 1 : period;
+
+    CoMomentWindow<Series> window(x, y, period);
+
+    for (int idx = 0; idx < size; ++idx) {
+        const bool full = window.push(idx);
+
+        if (cov_ptr) {
+            cov_ptr[idx] = full ? window.c_xy() / cov_divisor : nan;
+        }
+
+        if (corr_ptr) {
+            corr_ptr[idx] = full ? 
+                window.c_xy() / std::sqrt(window.m2_x() * window.m2_y()) : nan;
+        }
+
+        if (beta_ptr || alpha_ptr) {
+            const double beta = (window.c_xy() / period) / (window.m2_y() / var_divisor);
+
+            if (beta_ptr) {
+                beta_ptr[idx] = full ? beta : nan;
+            }
+
+            if (alpha_ptr) {
+                alpha_ptr[idx] = full ? window.mean_x() - beta * window.mean_y() : nan;
+            }
+        }
+    }
+}
+
+/*
+ * Covariance and correlation between one price array and another.
+ */
+template <typename T>
+void cov_kernel(const T *prices_ptr, const T *market_ptr, T *cov_ptr,
+        const int size, const int period, const bool normalize) {
+    comoment_kernel(ValueSeries<T>{prices_ptr}, ValueSeries<T>{market_ptr},
+            cov_ptr, (T *) nullptr, (T *) nullptr, (T *) nullptr, size, period,
+            normalize, false);
+}
+
+template <typename T>
+void corr_kernel(const T *prices_ptr, const T *market_ptr, T *corr_ptr,
+        const int size, const int period) {
+    comoment_kernel(ValueSeries<T>{prices_ptr}, ValueSeries<T>{market_ptr},
+            (T *) nullptr, corr_ptr, (T *) nullptr, (T *) nullptr, size, period,
+            false, false);
+}
+
+/*
+ * Implementation of BETA and ALPHA.
+ *
+ * Calculates the beta coefficient and alpha for a price array, from the
+ * percentage changes of the prices and the market.
+ * 
+ * @param prices (const T *): Array with prices.
+ * @param market (const T *): Array with market prices that beta is calculated from.
+ * @param period (int): Number of periods.
+ * @param normalize (bool): Specify whether to normalize the variance of the market.
+ *
+ * Observe that the first array is the array that beta will be calcualted for, and the second
+ * is the market that serves as the comparison.
+ *
+ */
+template <typename T>
+void beta_kernel(const T *prices_ptr, const T *market_ptr, T *beta_ptr,
+        const int size, const int period, const bool var_normalize) {
+    comoment_kernel(PctChangeSeries<T>{prices_ptr}, PctChangeSeries<T>{market_ptr},
+            (T *) nullptr, (T *) nullptr, beta_ptr, (T *) nullptr, size, period,
+            false, var_normalize);
+}
+
+template <typename T>
+void alpha_kernel(const T *prices_ptr, const T *market_ptr, T *alpha_ptr,
+        const int size, const int period, const bool var_normalize) {
+    comoment_kernel(PctChangeSeries<T>{prices_ptr}, PctChangeSeries<T>{market_ptr},
+            (T *) nullptr, (T *) nullptr, (T *) nullptr, alpha_ptr, size, period,
+            false, var_normalize);
+}
+
+/*
+ * Implementation of UNIVERSE_BETA.
+ *
+ * Beta and correlation of the percentage changes of every series in a panel
+ * against a single market series. The percentage changes of the market and
+ * their rolling mean and variance are calculated once for the whole panel,
+ * see SharedMoments in rolling.h, and the series are then calculated in
+ * parallel with CrossMomentWindow.
+ *
+ * @param prices (const T *): Array with the prices of one series.
+ * @param market (SharedMoments): Rolling moments of the market percentage
+ *      changes, with one value per bar of prices.
+ * @param beta (T *): Array to write beta to.
+ * @param corr (T *): Array to write the correlation to.
+ * @param period (int): Number of periods.
+ * @param var_normalize (bool): Normalize the variance of the market with
+ *      n - 1 instead of n, the same as for beta.
+ */
+template <typename T>
+void universe_beta_kernel(const T *prices_ptr, const SharedMoments &market,
+        T *beta_ptr, T *corr_ptr, const int size, const int period,
+        const bool var_normalize) {
+
+    if (period < 1) {
+        init_nan(beta_ptr, size);
+        init_nan(corr_ptr, size);
+        return;
+    }
+
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+    const double var_divisor = var_normalize ? period - 1 : period;
+
+    CrossMomentWindow<PctChangeSeries<T>> window(PctChangeSeries<T>{prices_ptr},
+            market, period);
+
+    for (int idx = 0; idx < size; ++idx) {
+        if (!window.push(idx)) {
+            beta_ptr[idx] = nan;
+            corr_ptr[idx] = nan;
+            continue;
+        }
+
+        beta_ptr[idx] = (window.c_xy() / period) / (market.m2[idx] / var_divisor);
+        corr_ptr[idx] = window.c_xy() / std::sqrt(window.m2_x() * market.m2[idx]);
+    }
+}
+
+// Number of matrix rows calculated together by one thread.
+#define MATRIX_ROW_BLOCK 16
+
+/*
+ * Implementation of COV_MATRIX and CORR_MATRIX.
+ *
+ * Rolling covariance (or correlation) matrix of all pairs of series in a
+ * panel. For the window ending at every bar, the sums of the values and the
+ * sums of the products of all pairs are kept, and each bar adds the products
+ * of the new values and subtracts the ones of the values that leave the
+ * window, which is O(N^2) per bar. Every period bars the sums are
+ * recalculated from the window, with the values taken relative to the mean
+ * of the window (shift), the same as for var.
+ *
+ * The rows of the matrix don't depend on each other, so blocks of
+ * MATRIX_ROW_BLOCK rows are calculated in parallel, and each block steps
+ * through time with its sums kept in cache. The full rows are kept instead
+ * of the upper triangle, so that the matrices are written row by row. A
+ * pair with NaN in the window gives NaN, NaN values are counted as zero in
+ * the sums to keep the other pairs intact.
+ *
+ * @param values_ptr (double*): Values with shape (size, n_series), one row
+ *      per bar.
+ * @param first (int): First bar written, period - 1 for every bar, or
+ *      size - 1 for the last matrix only.
+ * @param matrix_ptr: Output with one n_series x n_series matrix per bar from
+ *      first.
+ */
+template <typename T, bool corr>
+void comoment_matrix_rows(const double *values_ptr, const int size,
+        const int n_series, const int row_begin, const int row_end, const int first,
+        const int period, const double divisor, T *matrix_ptr) {
+
+    const int n_rows = row_end - row_begin;
+    const size_t matrix_size = (size_t) n_series * n_series;
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double inv_period = 1.0 / period;
+
+    std::vector<double> shift(n_series, 0.0);
+    std::vector<double> sum(n_series, 0.0);
+    std::vector<double> sum_sq(n_series, 0.0);
+    std::vector<double> scale(n_series);
+    std::vector<double> col_nan(n_series);
+    std::vector<double> value_in(n_series);
+    std::vector<double> value_out(n_series);
+    std::vector<double> cross((size_t) n_rows * n_series, 0.0);
+
+    // Index of the last NaN of each series up to the current bar.
+    std::vector<int> last_nan(n_series, -1);
+
+    auto shifted = [values_ptr, &shift, n_series](const int idx, double *value_ptr) {
+        const double *row_ptr = values_ptr + (size_t) idx * n_series;
+        for (int col = 0; col < n_series; ++col) {
+            value_ptr[col] = std::isnan(row_ptr[col]) ? 0.0 : row_ptr[col] - shift[col];
+        }
+    };
+
+    for (int idx = 0; idx < size; ++idx) {
+        const double *row_ptr = values_ptr + (size_t) idx * n_series;
+        for (int col = 0; col < n_series; ++col) {
+            if (std::isnan(row_ptr[col])) {
+                last_nan[col] = idx;
+            }
+        }
+
+        if (idx < first) {
+            continue;
+        }
+
+        if ((idx - first) % period == 0) {
+            for (int col = 0; col < n_series; ++col) {
+                double total = 0.0;
+                int count = 0;
+                for (int idx1 = idx - period + 1; idx1 <= idx; ++idx1) {
+                    const double value = values_ptr[(size_t) idx1 * n_series + col];
+                    if (!std::isnan(value)) {
+                        total += value;
+                        ++count;
+                    }
+                }
+                shift[col] = count > 0 ? total / count : 0.0;
+            }
+
+            std::fill(sum.begin(), sum.end(), 0.0);
+            std::fill(sum_sq.begin(), sum_sq.end(), 0.0);
+            std::fill(cross.begin(), cross.end(), 0.0);
+
+            for (int idx1 = idx - period + 1; idx1 <= idx; ++idx1) {
+                shifted(idx1, value_in.data());
+
+                for (int col = 0; col < n_series; ++col) {
+                    sum[col] += value_in[col];
+                    sum_sq[col] += value_in[col] * value_in[col];
+                }
+
+                for (int row = 0; row < n_rows; ++row) {
+                    const double value_row = value_in[row_begin + row];
+                    double *cross_ptr = cross.data() + (size_t) row * n_series;
+
+                    #pragma omp simd
+                    for (int col = 0; col < n_series; ++col) {
+                        cross_ptr[col] += value_row * value_in[col];
+                    }
+                }
+            }
+        }
+
+        else {
+            shifted(idx, value_in.data());
+            shifted(idx - period, value_out.data());
+
+            for (int col = 0; col < n_series; ++col) {
+                sum[col] += value_in[col] - value_out[col];
+                sum_sq[col] += value_in[col] * value_in[col] - value_out[col] * value_out[col];
+            }
+
+            for (int row = 0; row < n_rows; ++row) {
+                const double in_row = value_in[row_begin + row];
+                const double out_row = value_out[row_begin + row];
+                double *cross_ptr = cross.data() + (size_t) row * n_series;
+
+                #pragma omp simd
+                for (int col = 0; col < n_series; ++col) {
+                    cross_ptr[col] += in_row * value_in[col] - out_row * value_out[col];
+                }
+            }
+        }
+
+        // Per column terms of the output, NaN is added to the columns with
+        // NaN in the window.
+        for (int col = 0; col < n_series; ++col) {
+            const double m2 = std::max(sum_sq[col] - sum[col] * sum[col] / period, 0.0);
+            scale[col] = corr ? 1.0 / std::sqrt(m2) : 1.0 / divisor;
+            col_nan[col] = idx - last_nan[col] >= period ? 0.0 : nan;
+        }
+
+        T *out_ptr = matrix_ptr + (size_t) (idx - first) * matrix_size;
+        for (int row = 0; row < n_rows; ++row) {
+            const int series = row_begin + row;
+            const double *cross_ptr = cross.data() + (size_t) row * n_series;
+            T *row_ptr = out_ptr + (size_t) series * n_series;
+
+            if (idx - last_nan[series] < period) {
+                std::fill_n(row_ptr, n_series, (T) nan);
+                continue;
+            }
+
+            const double sum_row = sum[series];
+            const double scale_row = corr ? scale[series] : 1.0;
+
+            #pragma omp simd
+            for (int col = 0; col < n_series; ++col) {
+                row_ptr[col] = (cross_ptr[col] - sum_row * sum[col] * inv_period) * (scale_row * scale[col]) + col_nan[col];
+            }
+        }
+    }
+}
+
+/*
+ * COV_MATRIX or CORR_MATRIX of all series, see comoment_matrix_rows.
+ *
+ * @param values_ptr (double*): Values with shape (size, n_series), one row
+ *      per bar.
+ * @param matrix_ptr (T*): Output with one n_series x n_series matrix per
+ *      bar, or for the last bar only if final_only is set. Matrices before
+ *      the first full window are NaN.
+ * @param normalize (bool): Normalize the covariance with period - 1.
+ */
+template <typename T, bool corr>
+void comoment_matrix_kernel(const double *values_ptr, T *matrix_ptr, const int size,
+        const int n_series, const int period, const bool normalize, const bool final_only) {
+
+    // Bars written, from first to the last bar.
+    const int first = final_only ? size - 1 : std::max(period, 1) - 1;
+    const int n_matrices = final_only ? 1 : size;
+    const size_t matrix_size = (size_t) n_series * n_series;
+
+    if (period < 1 || first < period - 1 || first >= size) {
+        std::fill_n(matrix_ptr, (size_t) n_matrices * matrix_size,
+                std::numeric_limits<T>::quiet_NaN());
+        return;
+    }
+
+    std::fill_n(matrix_ptr, (size_t) (final_only ? 0 : first) * matrix_size,
+            std::numeric_limits<T>::quiet_NaN());
+    T *first_ptr = matrix_ptr + (size_t) (final_only ? 0 : first) * matrix_size;
+
+    const double divisor = normalize ? period - 1 : period;
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int row_begin = 0; row_begin < n_series; row_begin += MATRIX_ROW_BLOCK) {
+        const int row_end = std::min(row_begin + MATRIX_ROW_BLOCK, n_series);
+        comoment_matrix_rows<T, corr>(values_ptr, size, n_series, row_begin, row_end,
+                first, period, divisor, first_ptr);
+    }
+}
+
+/*
+ * Implementation of EWMA_COV and EWMA_CORR.
+ *
+ * Exponentially weighted covariance (or correlation) matrix of a panel of
+ * returns, as in RiskMetrics. The returns are assumed to have zero mean, so
+ * every bar decays the sums of the products of all pairs by lambda and adds
+ * the products of the new returns, which is O(N^2) per bar:
+ *      sum = lambda * sum + x * x', weight = lambda * weight + 1,
+ * with lambda = 0.5^(1 / halflife). The matrix is sum / weight, i.e. the
+ * weights are normalized from the first bar instead of seeding the matrix.
+ *
+ * If the panel contains NaN the weights are kept per pair, so a NaN in a
+ * series leaves the pairs of that series unchanged apart from the decay,
+ * and the other pairs intact. A pair without any common values is NaN.
+ * The correlation of a pair is then normalized with the sums of squares of
+ * both series over the bars they have in common, so it stays in [-1, 1].
+ * Otherwise all pairs share one weight, which halves the memory traffic.
+ * The rows are calculated in blocks in parallel, see COV_MATRIX.
+ */
+template <typename T, bool corr>
+void ewma_matrix_rows(const double *values_ptr, const int size,
+        const int n_series, const int row_begin, const int row_end, const double lambda,
+        const bool pair_weights, const bool final_only, T *matrix_ptr) {
+
+    const int n_rows = row_end - row_begin;
+    const size_t matrix_size = (size_t) n_series * n_series;
+
+    std::vector<double> value(n_series);
+    std::vector<double> valid(n_series);
+    std::vector<double> sum_sq(n_series, 0.0);
+    std::vector<double> weight_sq(n_series, 0.0);
+    std::vector<double> scale(n_series, 1.0);
+    std::vector<double> cross((size_t) n_rows * n_series, 0.0);
+    std::vector<double> weight(pair_weights ? (size_t) n_rows * n_series : n_series, 0.0);
+
+    // Sums of squares of the row and column series of each pair over their
+    // common bars, for the correlation with pair weights.
+    const bool pair_corr = corr && pair_weights;
+    std::vector<double> row_sq(pair_corr ? (size_t) n_rows * n_series : 0, 0.0);
+    std::vector<double> col_sq(pair_corr ? (size_t) n_rows * n_series : 0, 0.0);
+
+    for (int idx = 0; idx < size; ++idx) {
+        const double *row_ptr = values_ptr + (size_t) idx * n_series;
+        for (int col = 0; col < n_series; ++col) {
+            valid[col] = std::isnan(row_ptr[col]) ? 0.0 : 1.0;
+            value[col] = std::isnan(row_ptr[col]) ? 0.0 : row_ptr[col];
+            sum_sq[col] = lambda * sum_sq[col] + value[col] * value[col];
+            weight_sq[col] = lambda * weight_sq[col] + valid[col];
+        }
+
+        for (int row = 0; row < n_rows; ++row) {
+            const double value_row = value[row_begin + row];
+            const double valid_row = valid[row_begin + row];
+            double *cross_ptr = cross.data() + (size_t) row * n_series;
+            double *weight_ptr = weight.data() + (size_t) row * n_series;
+
+            #pragma omp simd
+            for (int col = 0; col < n_series; ++col) {
+                cross_ptr[col] = lambda * cross_ptr[col] + value_row * value[col];
+            }
+
+            if (pair_weights) {
+                #pragma omp simd
+                for (int col = 0; col < n_series; ++col) {
+                    weight_ptr[col] = lambda * weight_ptr[col] + valid_row * valid[col];
+                }
+            }
+
+            if (pair_corr) {
+                double *row_sq_ptr = row_sq.data() + (size_t) row * n_series;
+                double *col_sq_ptr = col_sq.data() + (size_t) row * n_series;
+                const double sq_row = value_row * value_row;
+
+                #pragma omp simd
+                for (int col = 0; col < n_series; ++col) {
+                    row_sq_ptr[col] = lambda * row_sq_ptr[col] + sq_row * valid[col];
+                    col_sq_ptr[col] = lambda * col_sq_ptr[col] + valid_row * (value[col] * value[col]);
+                }
+            }
+        }
+
+        // Without NaN, the shared weight is the same as the weights of the
+        // series themselves.
+        if (!pair_weights) {
+            std::copy(weight_sq.begin(), weight_sq.end(), weight.begin());
+        }
+
+        if (final_only && idx != size - 1) {
+            continue;
+        }
+
+        if (corr && !pair_corr) {
+            for (int col = 0; col < n_series; ++col) {
+                scale[col] = 1.0 / std::sqrt(sum_sq[col] / weight_sq[col]);
+            }
+        }
+
+        T *out_ptr = matrix_ptr + (final_only ? 0 : (size_t) idx * matrix_size);
+        for (int row = 0; row < n_rows; ++row) {
+            const int series = row_begin + row;
+            const double scale_row = scale[series];
+            const double *cross_ptr = cross.data() + (size_t) row * n_series;
+            const double *weight_ptr = weight.data() + (pair_weights ? (size_t) row * n_series : 0);
+            T *row_ptr = out_ptr + (size_t) series * n_series;
+
+            // The weights cancel in the correlation of a pair.
+            if (pair_corr) {
+                const double *row_sq_ptr = row_sq.data() + (size_t) row * n_series;
+                const double *col_sq_ptr = col_sq.data() + (size_t) row * n_series;
+
+                #pragma omp simd
+                for (int col = 0; col < n_series; ++col) {
+                    row_ptr[col] = cross_ptr[col] / std::sqrt(row_sq_ptr[col] * col_sq_ptr[col]);
+                }
+
+                continue;
+            }
+
+            #pragma omp simd
+            for (int col = 0; col < n_series; ++col) {
+                row_ptr[col] = cross_ptr[col] / weight_ptr[col] * (scale_row * scale[col]);
+            }
+        }
+    }
+}
+
+/*
+ * EWMA_COV or EWMA_CORR of all series, see ewma_matrix_rows.
+ *
+ * @param values_ptr (double*): Returns with shape (size, n_series), one row
+ *      per bar.
+ * @param matrix_ptr (T*): Output with one n_series x n_series matrix per
+ *      bar, or for the last bar only if final_only is set.
+ * @param halflife (double): Halflife of the weights in bars, positive.
+ */
+template <typename T, bool corr>
+void ewma_matrix_kernel(const double *values_ptr, T *matrix_ptr, const int size,
+        const int n_series, const double halflife, const bool final_only) {
+
+    // Without any bars the last matrix is NaN.
+    if (size == 0) {
+        std::fill_n(matrix_ptr, final_only ? (size_t) n_series * n_series : 0,
+                std::numeric_limits<T>::quiet_NaN());
+        return;
+    }
+
+    const double lambda = std::pow(0.5, 1.0 / halflife);
+    const bool pair_weights = std::any_of(values_ptr, values_ptr + (size_t) size * n_series,
+            [](const double value) { return std::isnan(value); });
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int row_begin = 0; row_begin < n_series; row_begin += MATRIX_ROW_BLOCK) {
+        const int row_end = std::min(row_begin + MATRIX_ROW_BLOCK, n_series);
+        ewma_matrix_rows<T, corr>(values_ptr, size, n_series, row_begin,
+                row_end, lambda, pair_weights, final_only, matrix_ptr);
+    }
+}
+
+/*
+ * Implementation of PCT_CHANGE.
+ *
+ * Calculates the percentage change of a price array.
+ */ 
+template <typename T>
+void pct_change_kernel(const T *prices_ptr, T *pct_change_ptr, const int size,
+        const int period) {
+
+    if (period < 1) {
+        init_nan(pct_change_ptr, size);
+        return;
+    }
+
+    init_nan(pct_change_ptr, std::min(size, period));
+
+    simd_for(period, size, [=](const int idx) {
+        pct_change_ptr[idx] = ((prices_ptr[idx] - prices_ptr[idx-period]) / 
+            prices_ptr[idx-period]) * 100;
+    });
+}
+
+/*
+ * Implementation of ROLLING_MAX, ROLLING_MIN, ROLLING_ARGMAX and ROLLING_ARGMIN.
+ *
+ * Maximum/minimum of the last period values, or with position set, where in
+ * the window it is, from 0 for the oldest value to period - 1 for the latest.
+ * Uses the monotonic window in rolling.h, so the cost doesn't depend on the
+ * period. Windows containing NaN give NaN.
+ */
+template <typename T, typename Compare, bool position>
+void rolling_extremum_kernel(const T *values_ptr, T *out_ptr, const int size,
+        const int period) {
+
+    if (period < 1) {
+        init_nan(out_ptr, size);
+        return;
+    }
+
+    init_nan(out_ptr, std::min(size, period - 1));
+
+    MonotonicWindow<T, Compare> window(values_ptr, period);
+
+    for (int idx = 0; idx < size; ++idx) {
+        window.push(idx);
+
+        if (idx < period - 1) {
+            continue;
+        }
+
+        if (window.has_nan(idx)) {
+            out_ptr[idx] = std::numeric_limits<T>::quiet_NaN();
+        }
+
+        else if (position) {
+            out_ptr[idx] = window.front() - (idx - period + 1);
+        }
+
+        else {
+            out_ptr[idx] = values_ptr[window.front()];
+        }
+    }
+}
+
+template <typename T>
+void rolling_max_kernel(const T *values_ptr, T *max_ptr, const int size,
+        const int period) {
+    rolling_extremum_kernel<T, std::greater<T>, false>(values_ptr, max_ptr, size, period);
+}
+
+template <typename T>
+void rolling_min_kernel(const T *values_ptr, T *min_ptr, const int size,
+        const int period) {
+    rolling_extremum_kernel<T, std::less<T>, false>(values_ptr, min_ptr, size, period);
+}
+
+template <typename T>
+void rolling_argmax_kernel(const T *values_ptr, T *argmax_ptr, const int size,
+        const int period) {
+    rolling_extremum_kernel<T, std::greater<T>, true>(values_ptr, argmax_ptr, size, period);
+}
+
+template <typename T>
+void rolling_argmin_kernel(const T *values_ptr, T *argmin_ptr, const int size,
+        const int period) {
+    rolling_extremum_kernel<T, std::less<T>, true>(values_ptr, argmin_ptr, size, period);
+}
+
+#endif
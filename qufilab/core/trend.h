@@ -0,0 +1,1151 @@
+#ifndef CORE_TREND_H
+#define CORE_TREND_H
+
+#include <vector>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <algorithm>
+#include <stdexcept>
+
+#include "util.h"
+#include "simd.h"
+#include "scan.h"
+
+/*
+ *  Moving averages.
+ *
+ *  Kernels working on a single series of size values, given as a pointer to
+ *  the first value. Outputs have the same size as the inputs and every
+ *  value is written, NaN during the warm-up. These are used by the python
+ *  modules and by the kernels of other indicators.
+ */
+
+/*
+ *  Streaming states for the moving averages.
+ *  Each state consumes one price at a time and keeps only what is needed
+ *  for the next value, so that a live feed doesn't have to recalculate the
+ *  whole history on every new bar. The values produced are identical to the
+ *  corresponding *_kernel function run over the full history, except that
+ *  EmaState and SmmaState step the serial recurrence, which ema_kernel and
+ *  smma_kernel only follow for the first SCAN_BLOCK values of the smoothing,
+ *  see affine_scan in scan.h. The constructors throw std::invalid_argument for a period below 1, which
+ *  pybind11 raises as a ValueError.
+ */
+template <typename T>
+class SmaState {
+    public:
+        SmaState(const int period);
+
+        // Consume a single price and return the latest sma value.
+        T update(const T price);
+
+        // Consume size prices and write the sma value after each price to
+        // values_ptr.
+        void update_many(const T *prices_ptr, T *values_ptr, const int size);
+
+        // Latest value, NaN until the first full period has been seen.
+        T value;
+
+    private:
+        int period;
+        bool started;
+        long count;
+        T sum;
+        int pos;
+        std::vector<T> window;
+};
+
+template <typename T>
+class EmaState {
+    public:
+        EmaState(const int period);
+        T update(const T price);
+        void update_many(const T *prices_ptr, T *values_ptr, const int size);
+        T value;
+
+    private:
+        int period;
+        bool started;
+        long count;
+        double seed;
+        T k;
+};
+
+template <typename T>
+class SmmaState {
+    public:
+        SmmaState(const int period);
+        T update(const T price);
+        void update_many(const T *prices_ptr, T *values_ptr, const int size);
+        T value;
+
+    private:
+        int period;
+        long count;
+        double seed;
+};
+
+template <typename T>
+class LwmaState {
+    public:
+        LwmaState(const int period);
+        T update(const T price);
+        void update_many(const T *prices_ptr, T *values_ptr, const int size);
+        T value;
+
+    private:
+        int period;
+        bool started;
+        long count;
+        int pos;
+        double plain;
+        double weighted;
+        std::vector<T> window;
+};
+
+/*
+    Implementation of SMA.
+    Simple Moving Average.
+
+    @param price_ptr (T*): Prices.
+    @param sma_ptr (T*): Output, same size as prices.
+    @param size (int): Number of prices.
+    @param periods (int): Number of periods.
+ */
+template <typename T>
+void sma_kernel(const T *price_ptr, T *sma_ptr, const int size, const int period) {
+    if (period < 1) {
+        init_nan(sma_ptr, size);
+        return;
+    }
+
+    // Check leading NaNs and adjust calculation below. This is needed if arg prices contain
+    // leading NaNs, which will occur when calculating other indicators.
+    int adjust_nan = 0;
+    for (int idx = 0; idx < size; ++idx) {
+        if (std::isnan(price_ptr[idx])) {
+            ++adjust_nan;
+        }
+
+        else {
+            break;
+        }
+    }
+
+    // Only the warm-up is NaN, every value after it is written below.
+    init_nan(sma_ptr, std::min(size, period - 1 + adjust_nan));
+
+    T temp = 0;
+    for (int idx = 0 + adjust_nan; idx < size; ++idx) {
+        temp += price_ptr[idx]; 
+
+        if (idx >= period + adjust_nan) {
+            temp -= price_ptr[idx - period];
+        }   
+
+        if (idx >= (period - 1 + adjust_nan)) {
+            sma_ptr[idx] = ((T) temp / period);
+        }
+    }
+}
+
+/*
+    Implementation of EMA.
+    Exponential Moving Average
+
+    Math: (close - ema(prev)) * k + ema(prev)
+
+    @param prices_ptr (T*): Prices.
+    @param ema_ptr (T*): Output, same size as prices.
+    @param size (int): Number of prices.
+    @param periods (int): Number of periods.
+
+    The smoothing after the first sma is a linear recurrence, calculated
+    in parallel blocks for long series, see affine_scan in scan.h.
+ */
+template <typename T>
+void ema_kernel(const T *prices_ptr, T *ema_ptr, const int size, const int periods) {
+    if (periods < 1) {
+        init_nan(ema_ptr, size);
+        return;
+    }
+
+    // Check leading NaNs and adjust calculation below. This is needed if arg prices contain
+    // leading NaNs, which will occur when calculating other indicators.
+    int adjust_nan = 0;
+    for (int idx = 0; idx < size; ++idx) {
+        if (std::isnan(prices_ptr[idx])) {
+            ++adjust_nan;
+        }
+
+        else {
+            break;
+        }
+    }
+
+    init_nan(ema_ptr, std::min(size, periods - 1 + adjust_nan));
+
+    // Not enough values for a first sma, which can happen for series in a panel.
+    if (periods + adjust_nan > size) {
+        return;
+    }
+
+    // Start with sma for first data point.
+    T prev = std::accumulate(prices_ptr + adjust_nan, prices_ptr + periods + adjust_nan, 0.0);
+    prev /= periods;
+
+    // Multiplier, i.e. 18.18% weight with period 10;
+    T k = (T) 2 / (periods + 1);
+    //prev = (prices[periods-1] - prev) * k + prev;
+    affine_scan(ema_ptr, periods - 1 + adjust_nan, size, prev, (T) 1 - k,
+        [=](const T prev, const int idx) {
+            return (prices_ptr[idx] - prev) * k + prev;
+        });
+}
+
+/*
+    EMA for PANEL_LANES series at once, stepping through time together so
+    that each series is kept in its own SIMD lane, see panel.h. The
+    arithmetic per series is the serial recurrence of ema_kernel, so the
+    values are the same for the first SCAN_BLOCK values of the smoothing.
+
+    @param prices_ptr (T*): Prices of the first series.
+    @param prices_step (ptrdiff_t): Step between two bars in prices.
+    @param ema_ptr (T*): Output of the first series.
+    @param ema_step (ptrdiff_t): Step between two bars in the output.
+    @param size (int): Number of prices.
+    @param periods (int): Number of periods.
+    @return (bool): False if the series have different number of leading NaNs
+        or are too short, in which case nothing is calculated.
+ */
+template <typename T>
+bool ema_lanes_kernel(const T *prices_ptr, const std::ptrdiff_t prices_step,
+        T *ema_ptr, const std::ptrdiff_t ema_step, const int size, const int periods) {
+
+    // Leading NaNs of the first series, all the others need to be the same.
+    int adjust_nan = 0;
+    while (adjust_nan < size && std::isnan(prices_ptr[adjust_nan * prices_step])) {
+        ++adjust_nan;
+    }
+
+    if (periods < 1 || periods + adjust_nan > size) {
+        return false;
+    }
+
+    for (int lane = 1; lane < PANEL_LANES; ++lane) {
+        for (int idx = 0; idx <= adjust_nan; ++idx) {
+            if (std::isnan(prices_ptr[idx * prices_step + lane]) != (idx < adjust_nan)) {
+                return false;
+            }
+        }
+    }
+
+    for (int idx = 0; idx < periods - 1 + adjust_nan; ++idx) {
+        std::fill(ema_ptr + idx * ema_step, ema_ptr + idx * ema_step + PANEL_LANES,
+                std::numeric_limits<T>::quiet_NaN());
+    }
+
+    // Start with sma for first data point.
+    double seed[PANEL_LANES] = {0.0};
+    for (int idx = adjust_nan; idx < periods + adjust_nan; ++idx) {
+        for (int lane = 0; lane < PANEL_LANES; ++lane) {
+            seed[lane] += prices_ptr[idx * prices_step + lane];
+        }
+    }
+
+    T prev[PANEL_LANES];
+    for (int lane = 0; lane < PANEL_LANES; ++lane) {
+        prev[lane] = seed[lane];
+        prev[lane] /= periods;
+        ema_ptr[(periods - 1 + adjust_nan) * ema_step + lane] = prev[lane];
+    }
+
+    const T k = (T) 2 / (periods + 1);
+    for (int idx = periods + adjust_nan; idx < size; ++idx) {
+        const T *price = prices_ptr + idx * prices_step;
+        T *ema = ema_ptr + idx * ema_step;
+
+        #pragma omp simd
+        for (int lane = 0; lane < PANEL_LANES; ++lane) {
+            prev[lane] = (price[lane] - prev[lane]) * k + prev[lane];
+            ema[lane] = prev[lane];
+        }
+    }
+
+    return true;
+}
+
+/*
+    Implementation of DEMA.
+    Double Exponential Moving Average
+
+    Math: DEMA = 2 * EMA_N - EMA(EMA_N).
+
+    Both ema stages are carried as running values, so the prices are only
+    read once and no intermediate arrays are allocated. The stages are
+    EmaState, which matches ema_kernel for the first SCAN_BLOCK values.
+
+    @param prices_ptr (T*): Prices.
+    @param dema_ptr (T*): Output, same size as prices.
+    @param size (int): Number of prices.
+    @param periods (int): Number of periods.
+ */
+template <typename T>
+void dema_kernel(const T *prices_ptr, T *dema_ptr, const int size, const int periods) {
+    if (periods < 1) {
+        init_nan(dema_ptr, size);
+        return;
+    }
+
+    EmaState<T> ema1(periods);
+    EmaState<T> ema2(periods);
+
+    // Second stage is NaN until 2*periods-2, which also gives the NaNs for dema.
+    for (int idx = 0; idx < size; ++idx) {
+        T e1 = ema1.update(prices_ptr[idx]);
+        T e2 = ema2.update(e1);
+        dema_ptr[idx] = 2 * e1 - e2;
+    }
+}
+
+/*
+    Implementation of TEMA.
+    Triple Exponential Moving Average
+    Math: TEMA = (3* EMA_1) - (3 * EMA_2) + EMA_3.
+
+    Single pass over the prices, see dema_kernel.
+
+    @param prices_ptr (T*): Prices.
+    @param tema_ptr (T*): Output, same size as prices.
+    @param size (int): Number of prices.
+    @param periods (int): Number of periods.
+ */
+template <typename T>
+void tema_kernel(const T *prices_ptr, T *tema_ptr, const int size, const int periods) {
+    if (periods < 1) {
+        init_nan(tema_ptr, size);
+        return;
+    }
+
+    EmaState<T> ema1(periods);
+    EmaState<T> ema2(periods);
+    EmaState<T> ema3(periods);
+
+    for (int idx = 0; idx < size; ++idx) {
+        T e1 = ema1.update(prices_ptr[idx]);
+        T e2 = ema2.update(e1);
+        T e3 = ema3.update(e2);
+        tema_ptr[idx] = (3*e1) - (3*e2) + e3;
+    }
+}
+
+/*
+    Implementation of T3.
+    T3 Moving Average.
+
+    Math: T3 = c1*e6 + c2*e5 + c3*e4 + c4*e3.
+        e1 = EMA (Close, Period)
+        e2 = EMA (e1, Period)
+        e3 = EMA (e2, Period)
+        e4 = EMA (e3, Period)
+        e5 = EMA (e4, Period)
+        e6 = EMA (e5, Period)
+        a is the volume factor, default value is 0.7 but 0.618 can also be used.
+        c1 = – a^3
+        c2 = 3*a^2 + 3*a^3
+        c3 = – 6*a^2 – 3*a – 3*a^3
+        c4 = 1 + 3*a + a^3 + 3*a^2
+
+    All six ema stages are carried as running values in a single pass over
+    the prices, and only the final output is written. The first value is
+    available when the sixth stage is, i.e. at index 6*(periods-1).
+
+    @param prices_ptr (T*): Prices.
+    @param t3_ptr (T*): Output, same size as prices.
+    @param size (int): Number of prices.
+    @param periods (int): Number of periods.
+    @param volume_factor (double): Volume factor a.
+ */
+template <typename T>
+void t3_kernel(const T *prices_ptr, T *t3_ptr, const int size, const int periods,
+        const double volume_factor) {
+
+    if (periods < 1) {
+        init_nan(t3_ptr, size);
+        return;
+    }
+
+    std::vector<EmaState<T>> ema(6, EmaState<T>(periods));
+
+    T c1 = -std::pow(volume_factor, 3);
+    T c2 = 3 * std::pow(volume_factor, 2) + 3 * std::pow(volume_factor, 3);
+    T c3 = - 6 * std::pow(volume_factor, 2) - 3 * volume_factor - 3 * std::pow(volume_factor, 3);
+    T c4 = 1 + 3 * volume_factor + std::pow(volume_factor, 3) + 3 * std::pow(volume_factor, 2);
+    
+    for (int idx = 0; idx < size; ++idx) {
+        T e1 = ema[0].update(prices_ptr[idx]);
+        T e2 = ema[1].update(e1);
+        T e3 = ema[2].update(e2);
+        T e4 = ema[3].update(e3);
+        T e5 = ema[4].update(e4);
+        T e6 = ema[5].update(e5);
+        t3_ptr[idx] = c1*e6 + c2*e5 + c3*e4 + c4*e3;
+    }
+}
+
+/*
+    Implementation of TMA.
+    Triangular Moving Average
+
+    Math: 
+        If period is even: first_period = period / 2.
+                           second_period = (period / 2) + 1.
+        If period is uneven: first_period = second_period = (period+1)/2 rounded up.
+
+        TMA = SMA(SMA(price, first_period), second_period)
+    
+    @param prices_ptr (T*): Prices.
+    @param tma_ptr (T*): Output, same size as prices.
+    @param size (int): Number of prices.
+    @param period (int): Number of periods.
+
+    OBSERVE that this implementation uses two sma calculations and can be optimzied
+    further by extending the original sma implementation. However, it is going to 
+    take some time doing the math so, leaving this for a rainy day.
+ */
+template <typename T>
+void tma_kernel(const T *prices_ptr, T *tma_ptr, const int size, const int period) {
+
+    int first_period;
+    int second_period;
+
+    if (period % 2 == 0) {
+        first_period = period / 2;
+        second_period = (period / 2) + 1;
+    }
+
+    else {
+        first_period = std::ceil((T) (period+1)/2);
+        second_period = std::ceil((T) (period+1)/2);
+    }
+
+    std::vector<T> sma(size);
+    sma_kernel(prices_ptr, sma.data(), size, first_period);
+    sma_kernel(sma.data(), tma_ptr, size, second_period);
+}
+
+/*
+   Implementation of SMMA.
+   Smoothed Moving Average.
+
+Math: 
+1. First value = sma.
+2. SMMA(i) = (SMMA1(i - 1) * (periods - 1) + prices(i)) / periods.
+
+@param prices_ptr (T*): Prices.
+@param smma_ptr (T*): Output, same size as prices.
+@param size (int): Number of prices.
+@param periods (int): Number of periods.
+
+The smoothing is calculated with affine_scan in the same way as the ema.
+*/
+template <typename T>
+void smma_kernel(const T *prices_ptr, T *smma_ptr, const int size, const int periods) {
+    if (periods < 1) {
+        init_nan(smma_ptr, size);
+        return;
+    }
+
+    init_nan(smma_ptr, std::min(size, periods - 1));
+
+    if (periods > size) {
+        return;
+    }
+
+    // Start with sma for first data point.
+    T prev = std::accumulate(prices_ptr, prices_ptr + periods, 0.0);
+    prev /= periods;
+    //double prev = (smma1 * (periods - 1) + prices[periods-1]) / periods;
+    affine_scan(smma_ptr, periods - 1, size, prev, (T) (periods - 1) / periods,
+        [=](const T prev, const int idx) {
+            return (prev * (periods - 1) + prices_ptr[idx]) / periods;
+        });
+}
+
+/*
+    SMMA for PANEL_LANES series at once, see ema_lanes_kernel.
+ */
+template <typename T>
+bool smma_lanes_kernel(const T *prices_ptr, const std::ptrdiff_t prices_step,
+        T *smma_ptr, const std::ptrdiff_t smma_step, const int size, const int periods) {
+
+    if (periods < 1 || periods > size) {
+        return false;
+    }
+
+    for (int idx = 0; idx < periods - 1; ++idx) {
+        std::fill(smma_ptr + idx * smma_step, smma_ptr + idx * smma_step + PANEL_LANES,
+                std::numeric_limits<T>::quiet_NaN());
+    }
+
+    // Start with sma for first data point.
+    double seed[PANEL_LANES] = {0.0};
+    for (int idx = 0; idx < periods; ++idx) {
+        for (int lane = 0; lane < PANEL_LANES; ++lane) {
+            seed[lane] += prices_ptr[idx * prices_step + lane];
+        }
+    }
+
+    T prev[PANEL_LANES];
+    for (int lane = 0; lane < PANEL_LANES; ++lane) {
+        prev[lane] = seed[lane];
+        prev[lane] /= periods;
+        smma_ptr[(periods - 1) * smma_step + lane] = prev[lane];
+    }
+
+    for (int idx = periods; idx < size; ++idx) {
+        const T *price = prices_ptr + idx * prices_step;
+        T *smma = smma_ptr + idx * smma_step;
+
+        #pragma omp simd
+        for (int lane = 0; lane < PANEL_LANES; ++lane) {
+            prev[lane] = (prev[lane] * (periods - 1) + price[lane]) / periods;
+            smma[lane] = prev[lane];
+        }
+    }
+
+    return true;
+}
+
+/*
+   Implementation of LWMA.
+   Linear Weighted Moving Average
+
+Math: LWMA = sum(prices[i] * W(i)) / sum(W),
+where W are the weights, ranging from 1-periods.
+
+When the window moves one step, every weight of the remaining prices
+decreases by one, so the weighted sum is updated with
+    weighted = weighted - plain + periods * price,
+where plain is the running (unweighted) sum of the window. This gives
+constant time per price. Both sums are kept in double precision, and every
+periods prices they are recalculated from the window, so the rounding errors
+of the updates don't add up over long series. LwmaState does the same, so
+its values stay identical to the kernel.
+
+@param prices_ptr (T*): Prices.
+@param lwma_ptr (T*): Output, same size as prices.
+@param size (int): Number of prices.
+@param periods (int): Number of periods.
+*/
+template <typename T>
+void lwma_kernel(const T *prices_ptr, T *lwma_ptr, const int size, const int periods) {
+
+    if (periods < 1) {
+        init_nan(lwma_ptr, size);
+        return;
+    }
+
+    // Check leading NaNs and adjust calculation below. This is needed if arg prices contain
+    // leading NaNs, which will occur when calculating other indicators.
+    int adjust_nan = 0;
+    for (int idx = 0; idx < size; ++idx) {
+        if (std::isnan(prices_ptr[idx])) {
+            ++adjust_nan;
+        }
+
+        else {
+            break;
+        }
+    }
+
+    init_nan(lwma_ptr, std::min(size, periods - 1 + adjust_nan));
+
+    const double W_sum = (double) periods * (periods + 1) / 2;
+    double plain = 0.0;
+    double weighted = 0.0;
+
+    for (int idx = 0 + adjust_nan; idx < size; ++idx) {
+        const int count = idx - adjust_nan;
+
+        if (count < periods) {
+            weighted += (double) prices_ptr[idx] * (count + 1);
+            plain += prices_ptr[idx];
+        }
+
+        else if ((count + 1) % periods != 0) {
+            weighted += (double) prices_ptr[idx] * periods - plain;
+            plain += (double) prices_ptr[idx] - prices_ptr[idx - periods];
+        }
+
+        else {
+            plain = 0.0;
+            weighted = 0.0;
+            for (int idx1 = 0; idx1 < periods; ++idx1) {
+                weighted += (double) prices_ptr[idx - periods + 1 + idx1] * (idx1 + 1);
+                plain += prices_ptr[idx - periods + 1 + idx1];
+            }
+        }
+
+        if (count >= periods - 1) {
+            lwma_ptr[idx] = weighted / W_sum;
+        }
+    }
+}
+
+/*
+   Implementation of WC.
+   Weighted Close.
+
+Math: wc[i] = ((close * 2) + high + low) / 4,
+
+@param closes_ptr (T*): Closing prices.
+@param highs_ptr (T*): High prices.
+@param lows_ptr (T*): Low prices.
+@param wc_ptr (T*): Output, same size as prices.
+@param size (int): Number of prices.
+*/
+template <typename T>
+void wc_kernel(const T *closes_ptr, const T *highs_ptr, const T *lows_ptr,
+        T *wc_ptr, const int size) {
+
+    simd_for(0, size, [=](const int idx) {
+        wc_ptr[idx] = ((closes_ptr[idx] * 2) + highs_ptr[idx] + lows_ptr[idx]) / 4;
+    });
+}
+
+/*
+ *  Moving average policies. Indicators built on a selectable moving average
+ *  take the policy as a template parameter, and the 'sma'/'ema' string from
+ *  python is resolved once per call with ma_select (indicators/_trend.h).
+ */
+struct SmaPolicy {
+    template <typename T>
+    static void kernel(const T *prices_ptr, T *ma_ptr, const int size, const int period) {
+        sma_kernel(prices_ptr, ma_ptr, size, period);
+    }
+};
+
+struct EmaPolicy {
+    template <typename T>
+    static void kernel(const T *prices_ptr, T *ma_ptr, const int size, const int period) {
+        ema_kernel(prices_ptr, ma_ptr, size, period);
+    }
+};
+
+// Number of prices per block in the multi-period moving averages. The prefix
+// sums for one block (and the windows reaching back from it) stay in cache
+// while all periods are calculated.
+#define MULTI_BLOCK_SIZE 4096
+
+/*
+ *  Compensated prefix sums, shared by the multi-period moving averages.
+ *
+ *  The sum of the first idx prices is stored as the pair hi[idx] + lo[idx],
+ *  where lo is the running Kahan compensation. This keeps the difference
+ *  between two prefix sums accurate even for very long arrays.
+ *
+ *  If weighted is true, the sums start again at every block of
+ *  MULTI_BLOCK_SIZE prices, and price idx is multiplied with its position in
+ *  the block plus one. The weights stay small, so the rounding of the
+ *  weighted prices doesn't grow with the length of the array, see
+ *  weighted_window_sum.
+ */
+template <typename T>
+void prefix_sum(const T *prices, const int size, const bool weighted,
+        std::vector<double> &hi, std::vector<double> &lo) {
+
+    hi.assign(size + 1, 0.0);
+    lo.assign(size + 1, 0.0);
+
+    double sum = 0.0;
+    double c = 0.0;
+    for (int idx = 0; idx < size; ++idx) {
+        const int position = idx % MULTI_BLOCK_SIZE;
+        if (weighted && position == 0) {
+            sum = 0.0;
+            c = 0.0;
+        }
+
+        double y = (weighted ? (double) prices[idx] * (position + 1) : prices[idx]) - c;
+        double t = sum + y;
+        c = (t - sum) - y;
+        sum = t;
+
+        hi[idx + 1] = sum;
+        lo[idx + 1] = -c;
+    }
+}
+
+// Sum of the values in [begin, end) from prefix sums created with prefix_sum.
+inline double window_sum(const double *hi, const double *lo,
+        const int begin, const int end) {
+    return (hi[end] - hi[begin]) + (lo[end] - lo[begin]);
+}
+
+/*
+ *  Sum of the prices in [begin, end) with weights 1..end-begin, from plain
+ *  and weighted prefix sums created with prefix_sum.
+ *
+ *  The window is summed one block of the weighted sums at a time. Within
+ *  the block starting at base, the weighted sums have weights idx - base + 1,
+ *  which are changed to idx - begin + 1 by adding base - begin times the
+ *  plain sum. Both terms are of the size of the window and the block, not
+ *  of the position in the array.
+ */
+inline double weighted_window_sum(const double *sum_hi, const double *sum_lo,
+        const double *weighted_hi, const double *weighted_lo,
+        const int begin, const int end) {
+
+    double weighted = 0.0;
+    for (int piece = begin; piece < end; ) {
+        const int base = piece - piece % MULTI_BLOCK_SIZE;
+        const int piece_end = std::min(end, base + MULTI_BLOCK_SIZE);
+
+        // At the start of a block the prefix sums hold the previous block.
+        double local = weighted_hi[piece_end] + weighted_lo[piece_end];
+        if (piece != base) {
+            local = (weighted_hi[piece_end] - weighted_hi[piece]) +
+                (weighted_lo[piece_end] - weighted_lo[piece]);
+        }
+
+        weighted += local + (double) (base - begin) *
+            window_sum(sum_hi, sum_lo, piece, piece_end);
+        piece = piece_end;
+    }
+
+    return weighted;
+}
+
+/*
+ *  Implementation of SMA_MULTI.
+ *  Simple Moving Average for multiple periods.
+ *
+ *  The prices are read once to create compensated prefix sums, thereafter
+ *  each value only needs a difference of two prefix sums. The work is split
+ *  into blocks of time that are calculated in parallel, and within a block
+ *  all periods are calculated while the prefix sums still are in cache.
+ *
+ *  @param prices_ptr (T*): Prices.
+ *  @param sma_ptr (T*): Output, one row of size values per period.
+ *  @param size (int): Number of prices.
+ *  @param periods (vector<int>): Periods to calculate, rows of periods below
+ *      1 are NaN.
+ */
+template <typename T>
+void sma_multi_kernel(const T *prices_ptr, T *sma_ptr, const int size,
+        const std::vector<int> &periods) {
+
+    const int n_periods = periods.size();
+
+    int adjust_nan = 0;
+    for (int idx = 0; idx < size; ++idx) {
+        if (std::isnan(prices_ptr[idx])) {
+            ++adjust_nan;
+        }
+
+        else {
+            break;
+        }
+    }
+
+    std::vector<double> sum_hi, sum_lo;
+    prefix_sum(prices_ptr + adjust_nan, size - adjust_nan, false, sum_hi, sum_lo);
+
+    #pragma omp parallel for schedule(static)
+    for (int start = 0; start < size; start += MULTI_BLOCK_SIZE) {
+        const int end = std::min(start + MULTI_BLOCK_SIZE, size);
+
+        for (int ii = 0; ii < n_periods; ++ii) {
+            const int period = periods[ii];
+            T *row_ptr = sma_ptr + (size_t) ii * size;
+
+            if (period < 1) {
+                std::fill(row_ptr + start, row_ptr + end, std::numeric_limits<T>::quiet_NaN());
+                continue;
+            }
+
+            const int first = std::min(std::max(start, period - 1 + adjust_nan), end);
+            for (int idx = start; idx < first; ++idx) {
+                row_ptr[idx] = std::numeric_limits<T>::quiet_NaN();
+            }
+
+            // Prefix sums are shifted by adjust_nan and by one.
+            for (int idx = first; idx < end; ++idx) {
+                const int sum_end = idx + 1 - adjust_nan;
+                row_ptr[idx] = window_sum(sum_hi.data(), sum_lo.data(), sum_end - period, sum_end) / period;
+            }
+        }
+    }
+}
+
+/*
+ *  Implementation of EMA_MULTI.
+ *  Exponential Moving Average for multiple periods.
+ *
+ *  The starting sma of every period is taken from one set of prefix sums.
+ *  The exponential smoothing is sequential in time, so here the periods are
+ *  calculated in parallel groups, and each group steps through the prices
+ *  in blocks that are shared by all periods in the group. The prices are
+ *  read while the rows are written, so the output can't overlap them.
+ *
+ *  @param prices_ptr (T*): Prices.
+ *  @param ema_ptr (T*): Output, one row of size values per period.
+ *  @param size (int): Number of prices.
+ *  @param periods (vector<int>): Periods to calculate, rows of periods below
+ *      1 are NaN.
+ */
+template <typename T>
+void ema_multi_kernel(const T *prices_ptr, T *ema_ptr, const int size,
+        const std::vector<int> &periods) {
+
+    const int n_periods = periods.size();
+    const int group_size = 16;
+
+    int adjust_nan = 0;
+    for (int idx = 0; idx < size; ++idx) {
+        if (std::isnan(prices_ptr[idx])) {
+            ++adjust_nan;
+        }
+
+        else {
+            break;
+        }
+    }
+
+    std::vector<double> sum_hi, sum_lo;
+    prefix_sum(prices_ptr + adjust_nan, size - adjust_nan, false, sum_hi, sum_lo);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int group = 0; group < n_periods; group += group_size) {
+        const int group_end = std::min(group + group_size, n_periods);
+        std::vector<T> prev(group_size);
+
+        for (int start = 0; start < size; start += MULTI_BLOCK_SIZE) {
+            const int end = std::min(start + MULTI_BLOCK_SIZE, size);
+
+            for (int ii = group; ii < group_end; ++ii) {
+                const int period = periods[ii];
+                T *row_ptr = ema_ptr + (size_t) ii * size;
+
+                if (period < 1) {
+                    std::fill(row_ptr + start, row_ptr + end, std::numeric_limits<T>::quiet_NaN());
+                    continue;
+                }
+
+                const int seed = period - 1 + adjust_nan;
+                const int first = std::min(std::max(start, seed), end);
+                const T k = (T) 2 / (period + 1);
+                T value = prev[ii - group];
+
+                for (int idx = start; idx < first; ++idx) {
+                    row_ptr[idx] = std::numeric_limits<T>::quiet_NaN();
+                }
+
+                for (int idx = first; idx < end; ++idx) {
+                    if (idx == seed) {
+                        value = window_sum(sum_hi.data(), sum_lo.data(), 0, period) / period;
+                    }
+
+                    else {
+                        value = (prices_ptr[idx] - value) * k + value;
+                    }
+
+                    row_ptr[idx] = value;
+                }
+
+                prev[ii - group] = value;
+            }
+        }
+    }
+}
+
+/*
+ *  Implementation of LWMA_MULTI.
+ *  Linear Weighted Moving Average for multiple periods.
+ *
+ *  Uses one plain and one weighted set of prefix sums, where the weights
+ *  start again in every block of MULTI_BLOCK_SIZE prices, see
+ *  weighted_window_sum. Blocked and parallel in the same way as
+ *  sma_multi_kernel.
+ *
+ *  @param prices_ptr (T*): Prices.
+ *  @param lwma_ptr (T*): Output, one row of size values per period.
+ *  @param size (int): Number of prices.
+ *  @param periods (vector<int>): Periods to calculate, rows of periods below
+ *      1 are NaN.
+ */
+template <typename T>
+void lwma_multi_kernel(const T *prices_ptr, T *lwma_ptr, const int size,
+        const std::vector<int> &periods) {
+
+    const int n_periods = periods.size();
+
+    int adjust_nan = 0;
+    for (int idx = 0; idx < size; ++idx) {
+        if (std::isnan(prices_ptr[idx])) {
+            ++adjust_nan;
+        }
+
+        else {
+            break;
+        }
+    }
+
+    std::vector<double> sum_hi, sum_lo, weighted_hi, weighted_lo;
+    prefix_sum(prices_ptr + adjust_nan, size - adjust_nan, false, sum_hi, sum_lo);
+    prefix_sum(prices_ptr + adjust_nan, size - adjust_nan, true, weighted_hi, weighted_lo);
+
+    #pragma omp parallel for schedule(static)
+    for (int start = 0; start < size; start += MULTI_BLOCK_SIZE) {
+        const int end = std::min(start + MULTI_BLOCK_SIZE, size);
+
+        for (int ii = 0; ii < n_periods; ++ii) {
+            const int period = periods[ii];
+            T *row_ptr = lwma_ptr + (size_t) ii * size;
+
+            if (period < 1) {
+                std::fill(row_ptr + start, row_ptr + end, std::numeric_limits<T>::quiet_NaN());
+                continue;
+            }
+
+            const double W_sum = (double) period * (period + 1) / 2;
+            const int first = std::min(std::max(start, period - 1 + adjust_nan), end);
+            for (int idx = start; idx < first; ++idx) {
+                row_ptr[idx] = std::numeric_limits<T>::quiet_NaN();
+            }
+
+            for (int idx = first; idx < end; ++idx) {
+                const int sum_end = idx + 1 - adjust_nan;
+                double weighted = weighted_window_sum(sum_hi.data(), sum_lo.data(),
+                    weighted_hi.data(), weighted_lo.data(), sum_end - period, sum_end);
+                row_ptr[idx] = weighted / W_sum;
+            }
+        }
+    }
+}
+
+/*
+ *  Streaming SMA.
+ *
+ *  Keeps the last period prices in a ring buffer together with the running
+ *  sum. Leading NaNs are skipped in the same way as in sma_kernel, and the
+ *  running sum is updated in the same order, giving identical values.
+ */
+template <typename T>
+SmaState<T>::SmaState(const int period) {
+    if (period < 1) {
+        throw std::invalid_argument("Param 'period' needs to be at least 1");
+    }
+    this -> period = period;
+    value = std::numeric_limits<T>::quiet_NaN();
+    started = false;
+    count = 0;
+    sum = 0;
+    pos = 0;
+    window.assign(period, 0);
+}
+
+template <typename T>
+T SmaState<T>::update(const T price) {
+    if (!started) {
+        if (std::isnan(price)) {
+            return value;
+        }
+
+        started = true;
+    }
+
+    sum += price;
+
+    if (count >= period) {
+        sum -= window[pos];
+    }
+
+    window[pos] = price;
+    pos = (pos + 1 == period) ? 0 : pos + 1;
+    ++count;
+
+    if (count >= period) {
+        value = ((T) sum / period);
+    }
+
+    return value;
+}
+
+template <typename T>
+void SmaState<T>::update_many(const T *prices_ptr, T *values_ptr, const int size) {
+    for (int idx = 0; idx < size; ++idx) {
+        values_ptr[idx] = update(prices_ptr[idx]);
+    }
+}
+
+/*
+ *  Streaming EMA.
+ *
+ *  The first value is the sma of the first period prices (summed in double
+ *  precision as in ema_kernel), thereafter the usual exponential smoothing.
+ */
+template <typename T>
+EmaState<T>::EmaState(const int period) {
+    if (period < 1) {
+        throw std::invalid_argument("Param 'period' needs to be at least 1");
+    }
+    this -> period = period;
+    value = std::numeric_limits<T>::quiet_NaN();
+    started = false;
+    count = 0;
+    seed = 0.0;
+    k = (T) 2 / (period + 1);
+}
+
+template <typename T>
+T EmaState<T>::update(const T price) {
+    if (!started) {
+        if (std::isnan(price)) {
+            return value;
+        }
+
+        started = true;
+    }
+
+    if (count < period) {
+        seed += price;
+        ++count;
+
+        if (count == period) {
+            value = seed;
+            value /= period;
+        }
+
+        return value;
+    }
+
+    value = (price - value) * k + value;
+    return value;
+}
+
+template <typename T>
+void EmaState<T>::update_many(const T *prices_ptr, T *values_ptr, const int size) {
+    for (int idx = 0; idx < size; ++idx) {
+        values_ptr[idx] = update(prices_ptr[idx]);
+    }
+}
+
+/*
+ *  Streaming SMMA.
+ *
+ *  As smma_kernel, the first value is the sma of the first period prices
+ *  and leading NaNs are not skipped.
+ */
+template <typename T>
+SmmaState<T>::SmmaState(const int period) {
+    if (period < 1) {
+        throw std::invalid_argument("Param 'period' needs to be at least 1");
+    }
+    this -> period = period;
+    value = std::numeric_limits<T>::quiet_NaN();
+    count = 0;
+    seed = 0.0;
+}
+
+template <typename T>
+T SmmaState<T>::update(const T price) {
+    if (count < period) {
+        seed += price;
+        ++count;
+
+        if (count == period) {
+            value = seed;
+            value /= period;
+        }
+
+        return value;
+    }
+
+    value = (value * (period - 1) + price) / period;
+    return value;
+}
+
+template <typename T>
+void SmmaState<T>::update_many(const T *prices_ptr, T *values_ptr, const int size) {
+    for (int idx = 0; idx < size; ++idx) {
+        values_ptr[idx] = update(prices_ptr[idx]);
+    }
+}
+
+/*
+ *  Streaming LWMA.
+ *
+ *  Keeps the last period prices in a ring buffer, which is only needed for
+ *  removing the oldest price from the running sums. Leading NaNs are skipped
+ *  and the sums are updated in the same order as in lwma_kernel.
+ */
+template <typename T>
+LwmaState<T>::LwmaState(const int period) {
+    if (period < 1) {
+        throw std::invalid_argument("Param 'period' needs to be at least 1");
+    }
+    this -> period = period;
+    value = std::numeric_limits<T>::quiet_NaN();
+    started = false;
+    count = 0;
+    pos = 0;
+    plain = 0.0;
+    weighted = 0.0;
+    window.assign(period, 0);
+}
+
+template <typename T>
+T LwmaState<T>::update(const T price) {
+    if (!started) {
+        if (std::isnan(price)) {
+            return value;
+        }
+
+        started = true;
+    }
+
+    if (count < period) {
+        weighted += (double) price * (count + 1);
+        plain += price;
+    }
+
+    else if ((count + 1) % period != 0) {
+        weighted += (double) price * period - plain;
+        plain += (double) price - window[pos];
+    }
+
+    window[pos] = price;
+    pos = (pos + 1 == period) ? 0 : pos + 1;
+    ++count;
+
+    // Recalculate the sums from the window in the same order as lwma_kernel,
+    // with the oldest price at pos.
+    if (count > period && count % period == 0) {
+        plain = 0.0;
+        weighted = 0.0;
+        for (int idx = 0; idx < period; ++idx) {
+            const T window_price = window[(pos + idx) % period];
+            weighted += (double) window_price * (idx + 1);
+            plain += window_price;
+        }
+    }
+
+    if (count >= period) {
+        value = weighted / ((double) period * (period + 1) / 2);
+    }
+
+    return value;
+}
+
+template <typename T>
+void LwmaState<T>::update_many(const T *prices_ptr, T *values_ptr, const int size) {
+    for (int idx = 0; idx < size; ++idx) {
+        values_ptr[idx] = update(prices_ptr[idx]);
+    }
+}
+
+#endif
@@ -0,0 +1,170 @@
+#ifndef INDICATOR_TRUE_RANGE_H
+#define INDICATOR_TRUE_RANGE_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "simd.h"
+
+/*
+ *  True range, the greatest of
+ *      1. Today's high minus todays's low.
+ *      2. Absolute value of today's high minus yesterday's close.
+ *      3. Absolute value of today's low minus yesterday's close.
+ *
+ *  The first value has no previous close and is NaN. Used by ATR and KC.
+ *
+ *  The SIMD variants take the maximum in the same order as the scalar loop,
+ *  with max(x, tr) returning tr unless x > tr, so NaN and signed zeros give
+ *  bitwise the same result on every path.
+ */
+template <typename T>
+void true_range_scalar(const T *closes_ptr, const T *highs_ptr, const T *lows_ptr,
+        T *tr_ptr, const int begin, const int end) {
+    for (int idx = begin; idx < end; ++idx) {
+        T condition1 = highs_ptr[idx] - lows_ptr[idx];
+        T condition2 = std::abs(highs_ptr[idx] - closes_ptr[idx-1]);
+        T condition3 = std::abs(lows_ptr[idx] - closes_ptr[idx-1]);
+        tr_ptr[idx] = std::max(std::max(condition1, condition2), condition3);
+    }
+}
+
+#ifdef SIMD_X86
+SIMD_TARGET("sse2")
+inline int true_range_sse2(const double *closes_ptr, const double *highs_ptr,
+        const double *lows_ptr, double *tr_ptr, const int size) {
+    const __m128d sign = _mm_set1_pd(-0.0);
+    int idx = 1;
+    for (; idx + 2 <= size; idx += 2) {
+        const __m128d close = _mm_loadu_pd(closes_ptr + idx - 1);
+        const __m128d high = _mm_loadu_pd(highs_ptr + idx);
+        const __m128d low = _mm_loadu_pd(lows_ptr + idx);
+        __m128d tr = _mm_sub_pd(high, low);
+        tr = _mm_max_pd(_mm_andnot_pd(sign, _mm_sub_pd(high, close)), tr);
+        tr = _mm_max_pd(_mm_andnot_pd(sign, _mm_sub_pd(low, close)), tr);
+        _mm_storeu_pd(tr_ptr + idx, tr);
+    }
+    return idx;
+}
+
+SIMD_TARGET("sse2")
+inline int true_range_sse2(const float *closes_ptr, const float *highs_ptr,
+        const float *lows_ptr, float *tr_ptr, const int size) {
+    const __m128 sign = _mm_set1_ps(-0.0f);
+    int idx = 1;
+    for (; idx + 4 <= size; idx += 4) {
+        const __m128 close = _mm_loadu_ps(closes_ptr + idx - 1);
+        const __m128 high = _mm_loadu_ps(highs_ptr + idx);
+        const __m128 low = _mm_loadu_ps(lows_ptr + idx);
+        __m128 tr = _mm_sub_ps(high, low);
+        tr = _mm_max_ps(_mm_andnot_ps(sign, _mm_sub_ps(high, close)), tr);
+        tr = _mm_max_ps(_mm_andnot_ps(sign, _mm_sub_ps(low, close)), tr);
+        _mm_storeu_ps(tr_ptr + idx, tr);
+    }
+    return idx;
+}
+
+SIMD_TARGET("avx2")
+inline int true_range_avx2(const double *closes_ptr, const double *highs_ptr,
+        const double *lows_ptr, double *tr_ptr, const int size) {
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    int idx = 1;
+    for (; idx + 4 <= size; idx += 4) {
+        const __m256d close = _mm256_loadu_pd(closes_ptr + idx - 1);
+        const __m256d high = _mm256_loadu_pd(highs_ptr + idx);
+        const __m256d low = _mm256_loadu_pd(lows_ptr + idx);
+        __m256d tr = _mm256_sub_pd(high, low);
+        tr = _mm256_max_pd(_mm256_andnot_pd(sign, _mm256_sub_pd(high, close)), tr);
+        tr = _mm256_max_pd(_mm256_andnot_pd(sign, _mm256_sub_pd(low, close)), tr);
+        _mm256_storeu_pd(tr_ptr + idx, tr);
+    }
+    return idx;
+}
+
+SIMD_TARGET("avx2")
+inline int true_range_avx2(const float *closes_ptr, const float *highs_ptr,
+        const float *lows_ptr, float *tr_ptr, const int size) {
+    const __m256 sign = _mm256_set1_ps(-0.0f);
+    int idx = 1;
+    for (; idx + 8 <= size; idx += 8) {
+        const __m256 close = _mm256_loadu_ps(closes_ptr + idx - 1);
+        const __m256 high = _mm256_loadu_ps(highs_ptr + idx);
+        const __m256 low = _mm256_loadu_ps(lows_ptr + idx);
+        __m256 tr = _mm256_sub_ps(high, low);
+        tr = _mm256_max_ps(_mm256_andnot_ps(sign, _mm256_sub_ps(high, close)), tr);
+        tr = _mm256_max_ps(_mm256_andnot_ps(sign, _mm256_sub_ps(low, close)), tr);
+        _mm256_storeu_ps(tr_ptr + idx, tr);
+    }
+    return idx;
+}
+
+SIMD_TARGET("avx512f")
+inline int true_range_avx512(const double *closes_ptr, const double *highs_ptr,
+        const double *lows_ptr, double *tr_ptr, const int size) {
+    int idx = 1;
+    for (; idx + 8 <= size; idx += 8) {
+        const __m512d close = _mm512_loadu_pd(closes_ptr + idx - 1);
+        const __m512d high = _mm512_loadu_pd(highs_ptr + idx);
+        const __m512d low = _mm512_loadu_pd(lows_ptr + idx);
+        __m512d tr = _mm512_sub_pd(high, low);
+        tr = _mm512_max_pd(_mm512_abs_pd(_mm512_sub_pd(high, close)), tr);
+        tr = _mm512_max_pd(_mm512_abs_pd(_mm512_sub_pd(low, close)), tr);
+        _mm512_storeu_pd(tr_ptr + idx, tr);
+    }
+    return idx;
+}
+
+SIMD_TARGET("avx512f")
+inline int true_range_avx512(const float *closes_ptr, const float *highs_ptr,
+        const float *lows_ptr, float *tr_ptr, const int size) {
+    int idx = 1;
+    for (; idx + 16 <= size; idx += 16) {
+        const __m512 close = _mm512_loadu_ps(closes_ptr + idx - 1);
+        const __m512 high = _mm512_loadu_ps(highs_ptr + idx);
+        const __m512 low = _mm512_loadu_ps(lows_ptr + idx);
+        __m512 tr = _mm512_sub_ps(high, low);
+        tr = _mm512_max_ps(_mm512_abs_ps(_mm512_sub_ps(high, close)), tr);
+        tr = _mm512_max_ps(_mm512_abs_ps(_mm512_sub_ps(low, close)), tr);
+        _mm512_storeu_ps(tr_ptr + idx, tr);
+    }
+    return idx;
+}
+#endif
+
+/*
+ *  True range of closes, highs and lows with size values, written to tr_ptr
+ *  by the variant for simd_level(). The values the vector loop leaves over
+ *  are calculated by the scalar loop.
+ */
+template <typename T>
+void true_range_kernel(const T *closes_ptr, const T *highs_ptr, const T *lows_ptr,
+        T *tr_ptr, const int size) {
+
+    if (size < 1) {
+        return;
+    }
+
+    tr_ptr[0] = std::numeric_limits<T>::quiet_NaN();
+    int done = 1;
+
+#ifdef SIMD_X86
+    switch (simd_level()) {
+        case SimdLevel::avx512:
+            done = true_range_avx512(closes_ptr, highs_ptr, lows_ptr, tr_ptr, size);
+            break;
+        case SimdLevel::avx2:
+            done = true_range_avx2(closes_ptr, highs_ptr, lows_ptr, tr_ptr, size);
+            break;
+        case SimdLevel::sse2:
+            done = true_range_sse2(closes_ptr, highs_ptr, lows_ptr, tr_ptr, size);
+            break;
+        default:
+            break;
+    }
+#endif
+
+    true_range_scalar(closes_ptr, highs_ptr, lows_ptr, tr_ptr, done, size);
+}
+
+#endif
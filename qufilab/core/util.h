@@ -2,6 +2,10 @@
 #ifndef INDICATOR_UTIL_H
 #define INDICATOR_UTIL_H
 
+#include <limits>
+
+// Number of series calculated together by the lanes kernels, see panel.h.
+#define PANEL_LANES 16
 
 template<typename T>
 void init_nan(T (&array), const int size) {
@@ -0,0 +1,271 @@
+#ifndef CORE_VOLATILITY_H
+#define CORE_VOLATILITY_H
+
+#include <vector>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "util.h"
+#include "rolling.h"
+#include "true_range.h"
+#include "scan.h"
+#include "trend.h"
+#include "stat.h"
+
+/*
+ *  Volatility indicators, kernels working on a single series of size values
+ *  (see trend.h).
+ */
+
+/*
+ *  Implementation of BBANDS.
+ *
+    Calculates Bollinger Bands.
+    Math: middle = SMA(periods).
+          top = middle + (std_dev * std)
+          bottom = middle - (std_dev * std)
+          percent_b = (price - bottom) / (top - bottom)
+          bandwidth = (top - bottom) / middle
+    
+    The mean and the standard deviation come from a single pass over the
+    prices, see MomentWindow in rolling.h. Outputs given as nullptr are
+    skipped.
+
+    @param prices (vector<double>): Vector with prices.
+    @param periods (int): Number of periods.
+    @param deviation (int): Number of deviations from the mean.
+        Multiplied with standard deviation.
+ */
+template <typename T>
+void bbands_kernel(const T *prices_ptr, T *upper_ptr, T *middle_ptr, T *lower_ptr,
+        T *percent_b_ptr, T *bandwidth_ptr, const int size, const int periods,
+        const int deviation) {
+
+    const T nan = std::numeric_limits<T>::quiet_NaN();
+
+    // Observe no normalization of the standard deviation.
+    MomentWindow<ValueSeries<T>> window(ValueSeries<T>{prices_ptr}, std::max(periods, 1));
+
+    for (int idx = 0; idx < size; ++idx) {
+        const bool full = window.push(idx) && periods >= 1;
+        const double middle = window.mean();
+        const double width = deviation * std::sqrt(window.m2() / periods);
+        const double upper = middle + width;
+        const double lower = middle - width;
+
+        if (upper_ptr) {
+            upper_ptr[idx] = full ? upper : nan;
+        }
+
+        if (middle_ptr) {
+            middle_ptr[idx] = full ? middle : nan;
+        }
+
+        if (lower_ptr) {
+            lower_ptr[idx] = full ? lower : nan;
+        }
+
+        if (percent_b_ptr) {
+            percent_b_ptr[idx] = full ? (prices_ptr[idx] - lower) / (upper - lower) : nan;
+        }
+
+        if (bandwidth_ptr) {
+            bandwidth_ptr[idx] = full ? (upper - lower) / middle : nan;
+        }
+    }
+}
+
+/*
+ * Implementation of ATR.
+ *
+    Consists of taking the exponential average (standard 14 days) of the True Range.
+    True Range vector will have one day's NaN since starting value should
+    compare to yesterday's closing price.
+
+    Math: True range-value is the greatest of the following, see true_range.h.
+        1. Today's high minus todays's low.
+        2. Absolute value of today's high minus yesterday's close.
+        3. Absolute value of today's low minus yesterday's close.
+
+    Observe that there exist 10 unstable periods when calculating using 10 periods,
+    since two of the conditions below includes yesterday prices, meaning the first ATR
+    can't be calcualted (since it doesn't exist any values before the first), and hence
+    one more NaN is included in the returned array.
+ */
+template <typename T>
+void atr_kernel(const T *prices_ptr, const T *highs_ptr, const T *lows_ptr,
+        T *atr_ptr, const int size, const int periods) {
+
+    if (periods < 1) {
+        init_nan(atr_ptr, size);
+        return;
+    }
+
+    init_nan(atr_ptr, std::min(size, periods));
+
+    if (periods >= size) {
+        return;
+    }
+
+    std::vector<T> tr(size);
+    const T *tr_ptr = tr.data();
+    true_range_kernel(prices_ptr, highs_ptr, lows_ptr, tr.data(), size);
+
+    // First ATR-value is a simple mean from the TR-values.
+    T first = std::accumulate(tr.begin() + 1, tr.begin() + periods + 1, 0.0) / periods;
+
+    // Subsequent ATR-values uses a smoothing average of the TR-values, a
+    // linear recurrence calculated with affine_scan, see scan.h.
+    affine_scan(atr_ptr, periods, size, first, (T) (periods - 1) / periods,
+        [=](const T prev, const int idx) {
+            return (prev * (periods - 1) + tr_ptr[idx]) / periods;
+        });
+}
+
+/*
+ * ATR for PANEL_LANES series at once, stepping through time together so that
+ * each series is kept in its own SIMD lane, see panel.h. The arithmetic per
+ * series is the serial recurrence of atr_kernel, so the values are the same
+ * for the first SCAN_BLOCK bars.
+ */
+template <typename T>
+bool atr_lanes_kernel(const T *prices_ptr, const T *highs_ptr, const T *lows_ptr,
+        const std::ptrdiff_t *steps, T *atr_ptr, const std::ptrdiff_t atr_step,
+        const int size, const int periods) {
+
+    if (periods < 1 || periods >= size) {
+        return false;
+    }
+
+    for (int idx = 0; idx < periods; ++idx) {
+        std::fill(atr_ptr + idx * atr_step, atr_ptr + idx * atr_step + PANEL_LANES,
+                std::numeric_limits<T>::quiet_NaN());
+    }
+
+    // First ATR-value is a simple mean from the TR-values.
+    double sum[PANEL_LANES] = {0.0};
+    for (int idx = 1; idx <= periods; ++idx) {
+        const T *price = prices_ptr + (idx - 1) * steps[0];
+        const T *high = highs_ptr + idx * steps[1];
+        const T *low = lows_ptr + idx * steps[2];
+
+        for (int lane = 0; lane < PANEL_LANES; ++lane) {
+            T condition1 = high[lane] - low[lane];
+            T condition2 = std::abs(high[lane] - price[lane]);
+            T condition3 = std::abs(low[lane] - price[lane]);
+            sum[lane] += std::max(std::max(condition1, condition2), condition3);
+        }
+    }
+
+    T prev[PANEL_LANES];
+    for (int lane = 0; lane < PANEL_LANES; ++lane) {
+        prev[lane] = sum[lane] / periods;
+        atr_ptr[periods * atr_step + lane] = prev[lane];
+    }
+
+    // Subsequent ATR-values uses a smoothing average of the TR-values
+    for (int idx = periods + 1; idx < size; ++idx) {
+        const T *price = prices_ptr + (idx - 1) * steps[0];
+        const T *high = highs_ptr + idx * steps[1];
+        const T *low = lows_ptr + idx * steps[2];
+        T *atr = atr_ptr + idx * atr_step;
+
+        #pragma omp simd
+        for (int lane = 0; lane < PANEL_LANES; ++lane) {
+            T condition1 = high[lane] - low[lane];
+            T condition2 = std::abs(high[lane] - price[lane]);
+            T condition3 = std::abs(low[lane] - price[lane]);
+            T tr = std::max(std::max(condition1, condition2), condition3);
+            prev[lane] = (prev[lane] * (periods - 1) + tr) / periods;
+            atr[lane] = prev[lane];
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Implementation of KC.
+ *
+ * Math: middle = EMA(periods).
+         top = middle + (deviation * ATR(periods_atr))
+         bottom = middle - (deviation * ATR(periods_atr))
+    
+    @param prices (vector<double>): Vector with prices.
+    @param periods (int): Number of periods.
+    @param periods_atr (int): Number of periods for the atr calculations.
+    @param deviation (int): Number of deviations from ema.
+        Multiplied with atr.
+ */
+template <typename T>
+void kc_kernel(const T *prices_ptr, const T *highs_ptr, const T *lows_ptr,
+        T *upper_ptr, T *middle_ptr, T *lower_ptr, const int size,
+        const int period, const int period_atr, const int deviation) {
+
+        if (period < 1) {
+            init_nan(upper_ptr, size);
+            init_nan(middle_ptr, size);
+            init_nan(lower_ptr, size);
+            return;
+        }
+
+        init_nan(lower_ptr, std::min(size, period));
+        init_nan(upper_ptr, std::min(size, period));
+
+        std::vector<T> atr(size);
+        ema_kernel(prices_ptr, middle_ptr, size, period);
+        atr_kernel(prices_ptr, highs_ptr, lows_ptr, atr.data(), size, period_atr);
+        
+        // If period_atr is greater than period, subtraction with NaN values
+        // will happen, however it is fine for now since it will also result in NaNs.
+        for (int idx = period; idx < size; ++idx) {
+            lower_ptr[idx] = middle_ptr[idx] - (deviation * atr[idx]);
+            upper_ptr[idx] = middle_ptr[idx] + (deviation * atr[idx]);
+        }
+
+        if (period - 1 < size) {
+            middle_ptr[period-1] = std::numeric_limits<T>::quiet_NaN();
+        }
+}
+
+/*
+ * Implementation of CV.
+ *
+    Math: True range-value is the greatest of the following.
+
+    @param highs (vector<double>): Vector with high prices.
+    @param lwos (vector<double>): Vector with low prices.
+    @param period (int): Number of periods.
+    @param smoothing_period (int): Number of periods for the smoothing of the ema.
+
+ */
+
+template <typename T>
+void cv_kernel(const T *highs_ptr, const T *lows_ptr, T *cv_ptr, const int size,
+        const int period, const int smoothing_period) {
+
+    if (period < 1 || smoothing_period < 1) {
+        init_nan(cv_ptr, size);
+        return;
+    }
+
+    std::vector<T> diff(size);
+
+    // Get difference between high and lows.
+    std::transform(highs_ptr, highs_ptr+size, lows_ptr, diff.begin(),
+        std::minus<T>());
+
+    // Calculate the ema for the differences.
+    std::vector<T> ema(size);
+    ema_kernel(diff.data(), ema.data(), size, period);
+        
+    init_nan(cv_ptr, std::min(size, period + smoothing_period - 2));
+
+    for (int idx = period + smoothing_period - 2; idx < size; ++idx) {
+        cv_ptr[idx] = ((ema[idx] - ema[idx - smoothing_period + 1]) / (ema[idx - smoothing_period + 1])) * 100;
+    }
+}
+
+#endif
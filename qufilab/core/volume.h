@@ -0,0 +1,251 @@
+#ifndef CORE_VOLUME_H
+#define CORE_VOLUME_H
+
+#include <vector>
+#include <cstddef>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include "util.h"
+#include "simd.h"
+#include "scan.h"
+#include "trend.h"
+
+/*
+ *  Volume indicators, kernels working on a single series of size values
+ *  (see trend.h).
+ */
+
+/*
+ * Implementation of ACDI.
+ *
+ * Additive scan of the money flow volume, see scan.h.
+ */
+template <typename T>
+void acdi_kernel(const T *prices_ptr, const T *highs_ptr, const T *lows_ptr,
+        const T *volumes_ptr, T *acdi_ptr, const int size) {
+
+    if (size == 0) {
+        return;
+    }
+
+    auto flow = [=](const int idx) -> T {
+        T nominator = highs_ptr[idx] - lows_ptr[idx];
+        // Santiy check, highs should never be higher than low.
+        if (nominator > 0.0) {
+            return (((prices_ptr[idx] - lows_ptr[idx]) - 
+                    (highs_ptr[idx] - prices_ptr[idx])) / nominator) * 
+                    (T)volumes_ptr[idx];
+        }
+
+        return 0.0;
+    };
+
+    T ad = 0.0;
+    ad += flow(0);
+    prefix_scan<AdditiveScan>(acdi_ptr, size, ad, flow);
+}
+
+/*
+ * Implementation of OBV.
+ *
+    @param (const T *) prices: Vector with prices.
+    @param (const T *) volumes: Vector with volumes.
+ */
+
+template <typename T>
+void obv_kernel(const T *prices_ptr, const T *volumes_ptr, T *obv_ptr,
+        const int size) {
+
+    if (size == 0) {
+        return;
+    }
+
+    prefix_scan<AdditiveScan>(obv_ptr, size, volumes_ptr[0], [=](const int idx) -> T {
+        if (prices_ptr[idx] > prices_ptr[idx-1]) {
+            return volumes_ptr[idx];
+        }
+
+        else if (prices_ptr[idx] < prices_ptr[idx-1]) {
+            return -volumes_ptr[idx];
+        }
+        
+        return 0.0;
+    });
+}
+
+/*
+ * Money flow volume of a single bar, the money flow multiplier times the
+ * volume. Like in ACDI a bar without range adds no money flow, instead of
+ * dividing by zero.
+ */
+template <typename T>
+inline T cmf_money_flow(const T *prices_ptr, const T *highs_ptr, const T *lows_ptr,
+        const T *volumes_ptr, const int idx) {
+    
+    T range = highs_ptr[idx] - lows_ptr[idx];
+    if (range <= 0.0) {
+        return 0.0;
+    }
+
+    return (((prices_ptr[idx] - lows_ptr[idx]) - (highs_ptr[idx] - prices_ptr[idx])) / 
+        range) * volumes_ptr[idx];
+}
+
+/*
+ * Implementation of CMF.
+ *
+    @param (vector<float>) prices: Vector with closing prices.
+    @param (vector<highs>) highs: Vector with high prices.
+    @param (vector<lows>) lows: Vector with low prices.
+    @param (vector<volumes>) volumes: Vector with volumes.
+    @param (int) periods: Number of periods. Standard 21.
+
+    The sums of money flow volume and volume over the window are updated
+    with the bar entering and the bar leaving it, so the cost per bar doesn't
+    depend on periods. The money flow of the leaving bar is calculated again
+    instead of being kept. Every periods bars the sums are calculated from
+    the window instead, so the rounding errors of the updates don't add up.
+    Bars with NaN are counted rather than summed, and make the value NaN
+    while they are in the window.
+ */
+template <typename T>
+void cmf_kernel(const T *prices_ptr, const T *highs_ptr, const T *lows_ptr,
+        const T *volumes_ptr, T *cmf_ptr, const int size, const int periods) {
+
+    if (periods < 1) {
+        init_nan(cmf_ptr, size);
+        return;
+    }
+
+    init_nan(cmf_ptr, std::min(size, periods - 1));
+
+    double flow = 0.0;
+    double volume = 0.0;
+    int nans = 0;
+
+    auto update = [&](const int idx, const int sign) {
+        T bar_flow = cmf_money_flow(prices_ptr, highs_ptr, lows_ptr, volumes_ptr, idx);
+        if (std::isnan(bar_flow) || std::isnan(volumes_ptr[idx])) {
+            nans += sign;
+        }
+
+        else {
+            flow += sign * (double) bar_flow;
+            volume += sign * (double) volumes_ptr[idx];
+        }
+    };
+
+    for (int idx = periods - 1; idx < size; ++idx) {
+        if ((idx + 1) % periods == 0) {
+            flow = 0.0;
+            volume = 0.0;
+            nans = 0;
+            for (int idx1 = idx - periods + 1; idx1 <= idx; ++idx1) {
+                update(idx1, 1);
+            }
+        }
+
+        else {
+            update(idx, 1);
+            update(idx - periods, -1);
+        }
+
+        if (nans > 0) {
+            cmf_ptr[idx] = std::numeric_limits<T>::quiet_NaN();
+        }
+
+        else {
+            cmf_ptr[idx] = (T) flow / (T) volume;
+        }
+    }
+}
+
+/*
+ * Implementation of CI.
+ *
+    @param (const T *) prices: Vector with closing prices.
+    @param (const T *) highs: Vector with high prices.
+    @param (const T *) lows: Vector with low prices.
+    @param (const T *) volumes: Vector with volumes.
+ */
+template <typename T>
+void ci_kernel(const T *prices_ptr, const T *highs_ptr, const T *lows_ptr,
+        const T *volumes_ptr, T *ci_ptr, const int size) {
+
+    init_nan(ci_ptr, std::min(size, 9));
+
+    std::vector<T> acdi(size);
+    acdi_kernel(prices_ptr, highs_ptr, lows_ptr, volumes_ptr, acdi.data(), size);
+
+    std::vector<T> ema10(size);
+    ema_kernel(acdi.data(), ema10.data(), size, 10);
+
+    std::vector<T> ema3(size);
+    ema_kernel(acdi.data(), ema3.data(), size, 3);
+
+    for (int idx = 9; idx < size; idx++) {
+        ci_ptr[idx] = ema3[idx] - ema10[idx];
+    }
+}
+
+/*
+ * Implementation of PVI.
+ *
+ *  Math: If volume_today > volume_yesterday:
+ *              PVI = PVI_yesterday + ((Close - Close_yesterday) / Close_yesterday) * PVI_yesterday
+ *      
+ *  @param (vector<float>) prices: Vector with closing prices.
+ *  @param (vector<volumes>) volumes: Vector with volumes.
+ *
+ */
+template <typename T>
+void pvi_kernel(const T *prices_ptr, const T *volumes_ptr, T *pvi_ptr,
+        const int size) {
+
+    if (size == 0) {
+        return;
+    }
+
+    // Relative scan of the price changes on the selected days, see scan.h.
+    prefix_scan<RelativeScan>(pvi_ptr, size, (T) 100.0, [=](const int idx) -> T {
+        if (volumes_ptr[idx] > volumes_ptr[idx-1]) {
+            return (prices_ptr[idx] - prices_ptr[idx-1]) / prices_ptr[idx-1];
+        }
+
+        return 0.0;
+    });
+}
+
+/*
+ *  Implementation of NVI.
+ *
+ *  Negative Volume Index
+ *
+ *  Math: If volume_today > volume_yesterday:
+ *              NVI = NVI_yesterday + ((Close - Close_yesterday) / Close_yesterday) * NVI_yesterday
+ *      
+ *  @param (vector<float>) prices: Vector with closing prices.
+ *  @param (vector<volumes>) volumes: Vector with volumes.
+ *
+ */
+template <typename T>
+void nvi_kernel(const T *prices_ptr, const T *volumes_ptr, T *nvi_ptr,
+        const int size) {
+
+    if (size == 0) {
+        return;
+    }
+
+    // Relative scan of the price changes on the selected days, see scan.h.
+    prefix_scan<RelativeScan>(nvi_ptr, size, (T) 100.0, [=](const int idx) -> T {
+        if (volumes_ptr[idx] < volumes_ptr[idx-1]) {
+            return (prices_ptr[idx] - prices_ptr[idx-1]) / prices_ptr[idx-1];
+        }
+
+        return 0.0;
+    });
+}
+
+#endif
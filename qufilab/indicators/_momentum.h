@@ -3,25 +3,33 @@
 
 
 #include <vector>
+#include <cstddef>
 #include <string>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 
+#include "panel.h"
+#include "../core/momentum.h"
+
 namespace py = pybind11;
 
+/*
+ *  Arrays can be 1D or 2D, see panel.h for the meaning of axis and out.
+ */
 template <typename T>
 py::array_t<T> rsi_calc(const py::array_t<T> prices,
-        const int periods, const std::string rsi_type);
+        const int periods, const std::string rsi_type,
+        const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 std::tuple<py::array_t<T>, py::array_t<T>> 
-    macd_calc(const py::array_t<T> prices);
+    macd_calc(const py::array_t<T> prices, const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> willr_calc(const py::array_t<T> prices,
         const py::array_t<T> highs,
         const py::array_t<T> lows,
-        const int periods);
+        const int periods, const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 std::tuple<std::vector<T>, std::vector<T>> 
@@ -33,25 +41,26 @@ std::tuple<std::vector<T>, std::vector<T>>
 
 template <typename T>
 py::array_t<T> roc_calc(const py::array_t<T> prices,
-        const int periods);
+        const int periods, const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> vpt_calc(const py::array_t<T> prices,
-        const py::array_t<T> volumes);
+        const py::array_t<T> volumes, const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> mi_calc(const py::array_t<T> prices,
-        const int periods);
+        const int periods, const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> cci_calc(const py::array_t<T> close,
         const py::array_t<T> high, const py::array_t<T> low,
-        const int period);
+        const int period, const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T>
         aroon_calc(const py::array_t<T> high, 
-        const py::array_t<T> low, const int period);
+        const py::array_t<T> low, const int period,
+        const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 std::vector<T> tsi_calc(const std::vector<T> close,
@@ -59,25 +68,30 @@ std::vector<T> tsi_calc(const std::vector<T> close,
 
 template <typename T>
 py::array_t<T> apo_calc(const py::array_t<T> prices,
-        const int period_slow, const int period_fast, const std::string ma);
+        const int period_slow, const int period_fast, const std::string ma,
+        const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> bop_calc(const py::array_t<T> high,
     const py::array_t<T> low, const py::array_t<T> open,
-    const py::array_t<T> close);
+    const py::array_t<T> close, const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> cmo_calc(const py::array_t<T> close,
-        const int period);
+        const int period, const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> mfi_calc(const py::array_t<T> high,
     const py::array_t<T> low, const py::array_t<T> close,
-    const py::array_t<T> volume, const int period);
+    const py::array_t<T> volume, const int period,
+    const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> ppo_calc(const py::array_t<T> prices,
         const int period_fast, const int period_slow, 
-        const std::string ma_type);
+        const std::string ma_type, const int axis = 0, const py::object out = py::none());
+
+// Adds the bindings of the module to the submodule m.
+void init_momentum(py::module &m);
 
 #endif
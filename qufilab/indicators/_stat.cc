@@ -12,235 +12,318 @@
 #include <limits>
 #include <numeric>
 #include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <functional>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 
 #include "_stat.h"
 #include "_trend.h"
-#include "util.h"
 
 namespace py = pybind11;
 
-/*
- * Implementation of STD.
- *
- * Calculates the standard deviation. 
- * Using normalization by default.
-*/
 
 template <typename T>
 py::array_t<T> std_calc(const py::array_t<T> prices,
-         const int period, const bool normalize) {
+         const int period, const bool normalize, const int axis, const py::object out) {
+    return panel_calc<T>({prices}, 1, axis, out, 
+        [period, normalize](const T * const *in, T * const *out, const int size) {
+            std_kernel(in[0], out[0], size, period, normalize);
+        })[0];
+}
 
-    py::buffer_info prices_buf = prices.request();
-    auto *prices_ptr = (T *) prices_buf.ptr;
-    const int size = prices_buf.shape[0];
 
-    auto sma = sma_calc(prices, period);
-    auto *sma_ptr = (T *) sma.request().ptr;
+template <typename T>
+py::array_t<T> var_calc(const py::array_t<T> prices,
+         const int period, const bool normalize, const int axis, const py::object out) {
+    return panel_calc<T>({prices}, 1, axis, out, 
+        [period, normalize](const T * const *in, T * const *out, const int size) {
+            var_kernel(in[0], out[0], size, period, normalize);
+        })[0];
+}
 
-    auto std = py::array_t<T>(prices_buf.size);
-    auto *std_ptr = (T *) std.request().ptr;
-    init_nan(std_ptr, size);
 
-    for (int ii = 0; ii < size - period+ 1; ii++) {
-        T temp = 0;
+template <typename T>
+py::array_t<T> cov_calc(const py::array_t<T> prices, const py::array_t<T> market,
+         const int period, const bool normalize, const int axis, const py::object out) {
+    return panel_calc<T>({prices, market}, 1, axis, out, 
+        [period, normalize](const T * const *in, T * const *out, const int size) {
+            cov_kernel(in[0], in[1], out[0], size, period, normalize);
+        })[0];
+}
 
-        for (int idx = ii; idx < period+ ii; idx++) {
-            temp += pow((prices_ptr[idx] - sma_ptr[ii+period-1]), 2);
-        }
+template <typename T>
+py::array_t<T> corr_calc(const py::array_t<T> prices, const py::array_t<T> market,
+         const int period, const int axis, const py::object out) {
+    return panel_calc<T>({prices, market}, 1, axis, out, 
+        [period](const T * const *in, T * const *out, const int size) {
+            corr_kernel(in[0], in[1], out[0], size, period);
+        })[0];
+}
 
-        if (normalize == true) {
-            temp /= (period - 1);
-        }
 
-        else {
-            temp /= (period);
-        }
-  
-        temp = sqrt(temp);
-        std_ptr[ii+period-1] = temp;
-    }
+template <typename T>
+py::array_t<T> beta_calc(const py::array_t<T> prices, const py::array_t<T> market,
+        const int period, const bool var_normalize,
+        const int axis, const py::object out) {
+    return panel_calc<T>({prices, market}, 1, axis, out, 
+        [period, var_normalize](const T * const *in, T * const *out, const int size) {
+            beta_kernel(in[0], in[1], out[0], size, period, var_normalize);
+        })[0];
+}
 
-    return std;
+template <typename T>
+py::array_t<T> alpha_calc(const py::array_t<T> prices, const py::array_t<T> market,
+        const int period, const bool var_normalize,
+        const int axis, const py::object out) {
+    return panel_calc<T>({prices, market}, 1, axis, out, 
+        [period, var_normalize](const T * const *in, T * const *out, const int size) {
+            alpha_kernel(in[0], in[1], out[0], size, period, var_normalize);
+        })[0];
 }
 
 /*
- * Implementation of VAR.
- *
- * Calculates the variance. 
-*/
+ * Beta and alpha together, in the same pass.
+ */
 template <typename T>
-py::array_t<T> var_calc(const py::array_t<T> prices,
-         const int period, const bool normalize) {
+std::tuple<py::array_t<T>, py::array_t<T>> 
+    beta_alpha_calc(const py::array_t<T> prices, const py::array_t<T> market,
+        const int period, const bool var_normalize,
+        const int axis, const py::object out) {
+
+    std::vector<py::array_t<T>> result = panel_calc<T>({prices, market}, 2, axis, out, 
+        [period, var_normalize](const T * const *in, T * const *out, const int size) {
+            comoment_kernel(PctChangeSeries<T>{in[0]}, PctChangeSeries<T>{in[1]},
+                (T *) nullptr, (T *) nullptr, out[0], out[1], size, period,
+                false, var_normalize);
+        });
+
+    return std::make_tuple(result[0], result[1]);
+}
 
-    py::buffer_info prices_buf = prices.request();
-    auto *prices_ptr = (T *) prices_buf.ptr;
-    const int size = prices_buf.shape[0];
 
-    auto sma = sma_calc(prices, period);
-    auto *sma_ptr = (T *) sma.request().ptr;
+template <typename T>
+std::tuple<py::array_t<T>, py::array_t<T>> 
+    universe_beta_calc(const py::array_t<T> prices, const py::array_t<T> market,
+        const int period, const bool var_normalize,
+        const int axis, const py::object out) {
 
-    auto var = py::array_t<T>(prices_buf.size);
-    auto *var_ptr = (T *) var.request().ptr;
-    init_nan(var_ptr, size);
+    py::buffer_info prices_buf = prices.request();
+    py::buffer_info market_buf = market.request();
 
-    int adjust_nan = 0;
-    for (int idx = 0; idx < size; ++idx) {
-        if (std::isnan(prices_ptr[idx])) {
-            ++adjust_nan;
-        }
+    if (market_buf.ndim != 1) {
+        throw py::value_error("Param 'market' needs to be a 1D array");
+    }
 
-        else {
-            break;
-        }
+    const int time_axis = prices_buf.ndim == 2 && axis == 1 ? 1 : 0;
+    if (prices_buf.ndim > 0 && market_buf.shape[0] != prices_buf.shape[time_axis]) {
+        throw py::value_error("Param 'market' needs to have one value per bar of 'prices'");
     }
 
-    for (int ii = 0 + adjust_nan; ii < size - period + 1; ii++) {
-        T temp = 0;
+    const T *market_ptr = (const T *) market_buf.ptr;
+    const std::ptrdiff_t market_step = market_buf.strides[0] / (py::ssize_t) sizeof(T);
+    const int market_size = market_buf.shape[0];
 
-        for (int idx = ii; idx < period+ ii; idx++) {
-            temp += pow((prices_ptr[idx] - sma_ptr[ii+period-1]), 2);
-        }
+    // The moments of the market are calculated without the GIL, in the
+    // same way as the kernels in panel_calc.
+    const SharedMoments market_moments = [=]() {
+        py::gil_scoped_release release;
 
-        if (normalize == true) {
-            temp /= (period- 1);
+        std::vector<T> market_values(market_size);
+        for (int idx = 0; idx < market_size; ++idx) {
+            market_values[idx] = market_ptr[idx * market_step];
         }
 
-        else {
-            temp /= (period);
-        }
-  
-        var_ptr[ii+period-1] = temp;
-    }
+        return SharedMoments(PctChangeSeries<T>{market_values.data()}, market_size,
+                std::max(period, 1));
+    }();
+
+    std::vector<py::array_t<T>> result = panel_calc<T>({prices}, 2, axis, out, 
+        [&market_moments, period, var_normalize](const T * const *in, T * const *out, const int size) {
+            universe_beta_kernel(in[0], market_moments, out[0], out[1], size, period,
+                var_normalize);
+        });
 
-    return var;
+    return std::make_tuple(result[0], result[1]);
 }
 
+
 /*
- * Implementation of COV.
- *
- * Calculates the covariance between one price array and another.. 
-*/
+ * 2D panel of the matrix indicators, copied with one row per bar, which is
+ * what the row blocks read.
+ */
+struct MatrixPanel {
+    int size;
+    int n_series;
+    std::vector<double> values;
+};
 
 template <typename T>
-py::array_t<T> cov_calc(const py::array_t<T> prices, const py::array_t<T> market,
-         const int period, const bool normalize) {
-
-    py::buffer_info prices_buf = prices.request();
-    auto *prices_ptr = (T *) prices_buf.ptr;
-    const int size = prices_buf.shape[0];
-    auto *market_ptr = (T *) market.request().ptr;
-
-    auto sma = sma_calc(prices, period);
-    auto sma_market = sma_calc(market, period);
-    auto *sma_ptr = (T *) sma.request().ptr;
-    auto *sma_market_ptr = (T *) sma_market.request().ptr;
-
-    auto cov = py::array_t<T>(prices_buf.size);
-    auto *cov_ptr = (T *) cov.request().ptr;
-    init_nan(cov_ptr, size);
-    
-    int adjust_nan = 0;
-    for (int idx = 0; idx < size; ++idx) {
-        if (std::isnan(prices_ptr[idx])) {
-            ++adjust_nan;
-        }
+MatrixPanel matrix_panel(const py::array_t<T> &values, const int axis) {
+    py::buffer_info values_buf = values.request();
+    if (values_buf.ndim != 2) {
+        throw py::value_error("Param 'values' needs to be a 2D array");
+    }
 
-        else {
-            break;
-        }
+    if (axis != 0 && axis != 1) {
+        throw py::value_error("Param 'axis' needs to be 0 or 1");
     }
 
-    for (int ii = 0 + adjust_nan; ii < size - period+ 1; ii++) {
-        T temp = 0;
+    MatrixPanel panel;
+    panel.size = values_buf.shape[axis];
+    panel.n_series = values_buf.shape[1 - axis];
+    panel.values.resize((size_t) panel.size * panel.n_series);
 
-        for (int idx = ii; idx < period + ii; idx++) {
-            temp += ((prices_ptr[idx] - sma_ptr[ii+period-1]) * 
-                (market_ptr[idx] - sma_market_ptr[ii+period-1]));
-        }
+    const T *values_ptr = (const T *) values_buf.ptr;
+    const std::ptrdiff_t step = values_buf.strides[axis] / (py::ssize_t) sizeof(T);
+    const std::ptrdiff_t series_step = values_buf.strides[1 - axis] / (py::ssize_t) sizeof(T);
 
-        if (normalize == true) {
-            temp /= (period - 1);
-        }
+    {
+        py::gil_scoped_release release;
 
-        else {
-            temp /= (period);
+        for (int idx = 0; idx < panel.size; ++idx) {
+            for (int col = 0; col < panel.n_series; ++col) {
+                panel.values[(size_t) idx * panel.n_series + col] =
+                    values_ptr[idx * step + col * series_step];
+            }
         }
-  
-        cov_ptr[ii+period-1] = temp;
     }
 
-    return cov;
+    return panel;
 }
 
 /*
- * Implementation of BETA.
- *
- * Calculates the beta coefficient for a price array.
- * 
- * @param prices (py::array_t<double>): Array with prices.
- * @param market (py::array_t<double>): Array with market prices that beta is calculated from.
- * @param period (int): Number of periods.
- * @param normalize (bool): Specify whether to normalize the variance of the market.
- *
- * Observe that the first array is the array that beta will be calcualted for, and the second
- * is the market that serves as the comparison.
- *
+ * Output of the matrix indicators, (size, n_series, n_series) or
+ * (n_series, n_series) for the last bar only.
  */
 template <typename T>
-py::array_t<T> beta_calc(const py::array_t<T> prices, const py::array_t<T> market,
-        const int period, const bool var_normalize) {
+py::array_t<T> matrix_output(const py::object &out, const MatrixPanel &panel,
+        const bool final_only) {
 
-    py::buffer_info prices_buf = prices.request();
-    const int size = prices_buf.shape[0];
-    
-    auto prices_pct = pct_change_calc(prices, 1);
-    auto market_pct = pct_change_calc(market, 1);
-
-    // Calculate the variance for the market.
-    auto var = var_calc(market_pct, period, var_normalize);
-    auto *var_ptr = (T *) var.request().ptr;
-
-    // Calculate covariance between price and market.
-    auto cov = cov_calc(prices_pct, market_pct, period, false);
-    auto *cov_ptr = (T *) cov.request().ptr;
-    
-    auto beta = py::array_t<T>(prices_buf.size);
-    auto *beta_ptr = (T *) beta.request().ptr;
-    init_nan(beta_ptr, size);
-
-    for (int idx = period; idx < size; ++idx) {
-        beta_ptr[idx] = cov_ptr[idx] / var_ptr[idx];
+    std::vector<py::ssize_t> shape = {panel.n_series, panel.n_series};
+    if (!final_only) {
+        shape.insert(shape.begin(), panel.size);
     }
 
-    return beta;
+    return output_array<T>(out, shape, true);
+}
+
+template <typename T, bool corr>
+py::array_t<T> comoment_matrix(const py::array_t<T> values, const int period,
+        const bool normalize, const bool final_only, const int axis, const py::object out) {
+
+    const MatrixPanel panel = matrix_panel(values, axis);
+    py::array_t<T> matrix = matrix_output<T>(out, panel, final_only);
+    T *matrix_ptr = (T *) matrix.request(true).ptr;
+
+    {
+        py::gil_scoped_release release;
+        comoment_matrix_kernel<T, corr>(panel.values.data(), matrix_ptr, panel.size,
+                panel.n_series, period, normalize, final_only);
+    }
+
+    return matrix;
 }
 
-/*
- * Implementation of PCT_CHANGE.
- *
- * Calculates the percentage change of a price array.
- */ 
 template <typename T>
-py::array_t<T> pct_change_calc(const py::array_t<T> prices, const int period) {
-    py::buffer_info prices_buf = prices.request();
-    const int size = prices_buf.shape[0];
-    auto *prices_ptr = (T *) prices_buf.ptr;
+py::array_t<T> cov_matrix_calc(const py::array_t<T> values, const int period,
+        const bool normalize, const bool final_only, const int axis, const py::object out) {
+    return comoment_matrix<T, false>(values, period, normalize, final_only, axis, out);
+}
+
+template <typename T>
+py::array_t<T> corr_matrix_calc(const py::array_t<T> values, const int period,
+        const bool final_only, const int axis, const py::object out) {
+    return comoment_matrix<T, true>(values, period, false, final_only, axis, out);
+}
+
+
+template <typename T, bool corr>
+py::array_t<T> ewma_matrix(const py::array_t<T> values, const double halflife,
+        const bool final_only, const int axis, const py::object out) {
+
+    if (!(halflife > 0)) {
+        throw py::value_error("Param 'halflife' needs to be positive");
+    }
 
-    auto pct_change = py::array_t<T>(prices_buf.size);
-    auto *pct_change_ptr = (T *) pct_change.request().ptr;
-    init_nan(pct_change_ptr, size);
+    const MatrixPanel panel = matrix_panel(values, axis);
+    py::array_t<T> matrix = matrix_output<T>(out, panel, final_only);
+    T *matrix_ptr = (T *) matrix.request(true).ptr;
 
-    for (int idx = period; idx < size; ++idx) {
-        pct_change_ptr[idx] = ((prices_ptr[idx] - prices_ptr[idx-period]) / 
-            prices_ptr[idx-period]) * 100;
+    {
+        py::gil_scoped_release release;
+        ewma_matrix_kernel<T, corr>(panel.values.data(), matrix_ptr, panel.size,
+                panel.n_series, halflife, final_only);
     }
 
-    return pct_change;
+    return matrix;
+}
+
+template <typename T>
+py::array_t<T> ewma_cov_calc(const py::array_t<T> values, const double halflife,
+        const bool final_only, const int axis, const py::object out) {
+    return ewma_matrix<T, false>(values, halflife, final_only, axis, out);
+}
+
+template <typename T>
+py::array_t<T> ewma_corr_calc(const py::array_t<T> values, const double halflife,
+        const bool final_only, const int axis, const py::object out) {
+    return ewma_matrix<T, true>(values, halflife, final_only, axis, out);
+}
+
+
+template <typename T>
+py::array_t<T> pct_change_calc(const py::array_t<T> prices, const int period,
+        const int axis, const py::object out) {
+    return panel_calc<T>({prices}, 1, axis, out, 
+        [period](const T * const *in, T * const *out, const int size) {
+            pct_change_kernel(in[0], out[0], size, period);
+        })[0];
+}
+
+
+template <typename T>
+py::array_t<T> rolling_max_calc(const py::array_t<T> values, const int period,
+        const int axis, const py::object out) {
+    return panel_calc<T>({values}, 1, axis, out, 
+        [period](const T * const *in, T * const *out, const int size) {
+            rolling_max_kernel(in[0], out[0], size, period);
+        })[0];
 }
 
-PYBIND11_MODULE(_stat, m) {
+template <typename T>
+py::array_t<T> rolling_min_calc(const py::array_t<T> values, const int period,
+        const int axis, const py::object out) {
+    return panel_calc<T>({values}, 1, axis, out, 
+        [period](const T * const *in, T * const *out, const int size) {
+            rolling_min_kernel(in[0], out[0], size, period);
+        })[0];
+}
+
+template <typename T>
+py::array_t<T> rolling_argmax_calc(const py::array_t<T> values, const int period,
+        const int axis, const py::object out) {
+    return panel_calc<T>({values}, 1, axis, out, 
+        [period](const T * const *in, T * const *out, const int size) {
+            rolling_argmax_kernel(in[0], out[0], size, period);
+        })[0];
+}
+
+template <typename T>
+py::array_t<T> rolling_argmin_calc(const py::array_t<T> values, const int period,
+        const int axis, const py::object out) {
+    return panel_calc<T>({values}, 1, axis, out, 
+        [period](const T * const *in, T * const *out, const int size) {
+            rolling_argmin_kernel(in[0], out[0], size, period);
+        })[0];
+}
+
+/*
+ *  Bindings of the _stat submodule, added to the _qufilab extension in
+ *  qufilab/_qufilab.cc.
+ */
+void init_stat(py::module &m) {
     m.def("std_calc", &std_calc<double>, "Standard Deviation");
     m.def("std_calc", &std_calc<float>, "Standard Deviation");
 
@@ -253,6 +336,45 @@ PYBIND11_MODULE(_stat, m) {
     m.def("beta_calc", &beta_calc<double>, "Beta");
     m.def("beta_calc", &beta_calc<float>, "Beta");
 
+    m.def("corr_calc", &corr_calc<double>, "Correlation");
+    m.def("corr_calc", &corr_calc<float>, "Correlation");
+
+    m.def("alpha_calc", &alpha_calc<double>, "Alpha");
+    m.def("alpha_calc", &alpha_calc<float>, "Alpha");
+
+    m.def("beta_alpha_calc", &beta_alpha_calc<double>, "Beta and Alpha");
+    m.def("beta_alpha_calc", &beta_alpha_calc<float>, "Beta and Alpha");
+
+    m.def("universe_beta_calc", &universe_beta_calc<double>, "Universe Beta and Correlation");
+    m.def("universe_beta_calc", &universe_beta_calc<float>, "Universe Beta and Correlation");
+
+    m.def("cov_matrix_calc", &cov_matrix_calc<double>, "Covariance Matrix");
+    m.def("cov_matrix_calc", &cov_matrix_calc<float>, "Covariance Matrix");
+
+    m.def("corr_matrix_calc", &corr_matrix_calc<double>, "Correlation Matrix");
+    m.def("corr_matrix_calc", &corr_matrix_calc<float>, "Correlation Matrix");
+
+    m.def("ewma_cov_calc", &ewma_cov_calc<double>, "EWMA Covariance Matrix");
+    m.def("ewma_cov_calc", &ewma_cov_calc<float>, "EWMA Covariance Matrix");
+
+    m.def("ewma_corr_calc", &ewma_corr_calc<double>, "EWMA Correlation Matrix");
+    m.def("ewma_corr_calc", &ewma_corr_calc<float>, "EWMA Correlation Matrix");
+
     m.def("pct_change_calc", &pct_change_calc<double>, "Percentage change");
     m.def("pct_change_calc", &pct_change_calc<float>, "Percentage change");
+
+    m.def("rolling_max_calc", &rolling_max_calc<double>, "Rolling maximum");
+    m.def("rolling_max_calc", &rolling_max_calc<float>, "Rolling maximum");
+
+    m.def("rolling_min_calc", &rolling_min_calc<double>, "Rolling minimum");
+    m.def("rolling_min_calc", &rolling_min_calc<float>, "Rolling minimum");
+
+    m.def("rolling_argmax_calc", &rolling_argmax_calc<double>, "Rolling position of the maximum");
+    m.def("rolling_argmax_calc", &rolling_argmax_calc<float>, "Rolling position of the maximum");
+
+    m.def("rolling_argmin_calc", &rolling_argmin_calc<double>, "Rolling position of the minimum");
+    m.def("rolling_argmin_calc", &rolling_argmin_calc<float>, "Rolling position of the minimum");
+
+    simd_register("pct_change");
+    m.def("_simd_kernels", &simd_kernels, "SIMD level of the kernels");
 }
@@ -3,30 +3,94 @@
 #ifndef STAT_H
 #define STAT_H
 
+#include <tuple>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 
+#include "panel.h"
+#include "../core/stat.h"
+
 namespace py = pybind11;
 
+/*
+ *  Arrays can be 1D or 2D, see panel.h for the meaning of axis and out.
+ */
 template <typename T>
 py::array_t<T> std_calc(const py::array_t<T> prices,
-        const int period, const bool normalize);
+        const int period, const bool normalize, const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> var_calc(const py::array_t<T> prices,
-        const int period, const bool normalize);
+        const int period, const bool normalize, const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> cov_calc(const py::array_t<T> prices,
         const py::array_t<T> market, const int period, 
-        const bool normalize);
+        const bool normalize, const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> beta_calc(const py::array_t<T> prices,
         const py::array_t<T> market, const int period, 
-        const bool var_normalize);
+        const bool var_normalize, const int axis = 0, const py::object out = py::none());
+
+template <typename T>
+py::array_t<T> corr_calc(const py::array_t<T> prices,
+        const py::array_t<T> market, const int period, 
+        const int axis = 0, const py::object out = py::none());
+
+template <typename T>
+py::array_t<T> alpha_calc(const py::array_t<T> prices,
+        const py::array_t<T> market, const int period, 
+        const bool var_normalize, const int axis = 0, const py::object out = py::none());
+
+template <typename T>
+std::tuple<py::array_t<T>, py::array_t<T>> beta_alpha_calc(const py::array_t<T> prices,
+        const py::array_t<T> market, const int period, 
+        const bool var_normalize, const int axis = 0, const py::object out = py::none());
+
+template <typename T>
+std::tuple<py::array_t<T>, py::array_t<T>> universe_beta_calc(const py::array_t<T> prices,
+        const py::array_t<T> market, const int period, 
+        const bool var_normalize, const int axis = 0, const py::object out = py::none());
+
+template <typename T>
+py::array_t<T> cov_matrix_calc(const py::array_t<T> values, const int period,
+        const bool normalize, const bool final_only, const int axis = 0,
+        const py::object out = py::none());
+
+template <typename T>
+py::array_t<T> corr_matrix_calc(const py::array_t<T> values, const int period,
+        const bool final_only, const int axis = 0, const py::object out = py::none());
+
+template <typename T>
+py::array_t<T> ewma_cov_calc(const py::array_t<T> values, const double halflife,
+        const bool final_only, const int axis = 0, const py::object out = py::none());
+
+template <typename T>
+py::array_t<T> ewma_corr_calc(const py::array_t<T> values, const double halflife,
+        const bool final_only, const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> pct_change_calc(const py::array_t<T> prices,
-        const int period);
+        const int period, const int axis = 0, const py::object out = py::none());
+
+template <typename T>
+py::array_t<T> rolling_max_calc(const py::array_t<T> values,
+        const int period, const int axis = 0, const py::object out = py::none());
+
+template <typename T>
+py::array_t<T> rolling_min_calc(const py::array_t<T> values,
+        const int period, const int axis = 0, const py::object out = py::none());
+
+template <typename T>
+py::array_t<T> rolling_argmax_calc(const py::array_t<T> values,
+        const int period, const int axis = 0, const py::object out = py::none());
+
+template <typename T>
+py::array_t<T> rolling_argmin_calc(const py::array_t<T> values,
+        const int period, const int axis = 0, const py::object out = py::none());
+
+// Adds the bindings of the module to the submodule m.
+void init_stat(py::module &m);
+
 #endif
@@ -3,40 +3,91 @@
 
 #include <iostream>
 #include <vector>
+#include <cstddef>
+#include <string>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <pybind11/numpy.h>
 
+#include "panel.h"
+#include "../core/trend.h"
+
 namespace py = pybind11;
 
+/*
+ *  Returns sma or ema, which are the SmaPolicy and EmaPolicy instantiations
+ *  of the same kernel, depending on ma.
+ */
+template <typename Kernel>
+Kernel ma_select(const std::string &ma, const Kernel sma, const Kernel ema) {
+    if (ma == "sma") {
+        return sma;
+    }
+
+    else if (ma == "ema") {
+        return ema;
+    }
+
+    throw py::value_error("Param 'ma' needs to be 'sma' or 'ema'");
+}
+
+/*
+ *  Arrays can be 1D or 2D, see panel.h for the meaning of axis and out.
+ */
 template <typename T>
-py::array_t<T> sma_calc(const py::array_t<T> price, const int period);
+py::array_t<T> sma_calc(const py::array_t<T> price, const int period,
+        const int axis = 0, const py::object out = py::none());
 
 template <typename T>
-py::array_t<T> ema_calc(const py::array_t<T> prices, const int periods);
+py::array_t<T> ema_calc(const py::array_t<T> prices, const int periods,
+        const int axis = 0, const py::object out = py::none());
 
 template <typename T>
-py::array_t<T> dema_calc(const py::array_t<T> prices, const int periods);
+py::array_t<T> dema_calc(const py::array_t<T> prices, const int periods,
+        const int axis = 0, const py::object out = py::none());
 
 template <typename T>
-py::array_t<T> tema_calc(const py::array_t<T> prices, const int periods);
+py::array_t<T> tema_calc(const py::array_t<T> prices, const int periods,
+        const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> t3_calc(const py::array_t<T> prices, const int periods,
-        const double volume_factor);
+        const double volume_factor, const int axis = 0, const py::object out = py::none());
 
 template <typename T>
-py::array_t<T> tma_calc(const py::array_t<T> prices, const int periods);
+py::array_t<T> tma_calc(const py::array_t<T> prices, const int periods,
+        const int axis = 0, const py::object out = py::none());
 
 template <typename T>
-py::array_t<T> smma_calc(const py::array_t<T> prices, const int periods);
+py::array_t<T> smma_calc(const py::array_t<T> prices, const int periods,
+        const int axis = 0, const py::object out = py::none());
 
 template <typename T>
-py::array_t<T> lwma_calc(const py::array_t<T> prices, const int periods);
+py::array_t<T> lwma_calc(const py::array_t<T> prices, const int periods,
+        const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> wc_calc(const py::array_t<T> prices, 
         const py::array_t<T> highs,
-        const py::array_t<T> lows);
+        const py::array_t<T> lows,
+        const int axis = 0, const py::object out = py::none());
+
+template <typename T>
+py::array_t<T> sma_multi_calc(const ContiguousArray<T> prices,
+        const std::vector<int> periods, const py::object out = py::none());
+
+template <typename T>
+py::array_t<T> ema_multi_calc(const ContiguousArray<T> prices,
+        const std::vector<int> periods, const py::object out = py::none());
+
+template <typename T>
+py::array_t<T> lwma_multi_calc(const ContiguousArray<T> prices,
+        const std::vector<int> periods, const py::object out = py::none());
+
+template <typename State, typename T>
+py::array_t<T> state_update_many(State &state, const ContiguousArray<T> prices);
+
+// Adds the bindings of the module to the submodule m.
+void init_trend(py::module &m);
 
 #endif
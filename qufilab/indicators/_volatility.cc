@@ -13,267 +13,159 @@
 #include <chrono>
 #include <limits>
 #include <cstdint>
+#include <cstddef>
+#include <algorithm>
 #include <omp.h>
-#include <x86intrin.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 
 #include "_volatility.h"
 #include "_trend.h"
 #include "_stat.h"
-#include "util.h"
 
 namespace py = pybind11;
 
 
-/*
- *  Implementation of BBANDS.
- *
-    Calculates Bollinger Bands.
-    Math: middle = SMA(periods).
-          top = middle + (std_dev * std)
-          bottom = middle - (std_dev * std)
-    
-    @param prices (vector<double>): Vector with prices.
-    @param periods (int): Number of periods.
-    @param deviation (int): Number of deviations from the mean.
-        Multiplied with standard deviation.
-
-    @return (tuple): Lower and upper bollinger bands.
- */
 template <typename T>
 std::tuple<py::array_t<T>, py::array_t<T>, py::array_t<T>> 
     bbands_calc(const py::array_t<T> prices, 
-        const int periods, const int deviation) {
-   
-    py::buffer_info prices_buf = prices.request();
-    auto *prices_ptr = (T *) prices_buf.ptr;
-    const int size = prices_buf.shape[0];
-
-    auto sma = sma_calc(prices, periods);
-    const auto *sma_ptr = (T *) sma.request().ptr;
-
-    // Observe no normalization of the standard deviation.
-    auto std = std_calc(prices, periods, false);
-    const auto *std_ptr = (T *) std.request().ptr;
-
-    auto middle = py::array_t<T>(prices_buf.size);
-    auto lower = py::array_t<T>(prices_buf.size);
-    auto upper = py::array_t<T>(prices_buf.size);
-    auto *middle_ptr = (T *) middle.request().ptr;
-    auto *lower_ptr = (T *) lower.request().ptr;
-    auto *upper_ptr = (T *) upper.request().ptr;
-
-    init_nan(middle_ptr, size);
-    init_nan(lower_ptr, size);
-    init_nan(upper_ptr, size);
-    
-    for (int idx = periods-1; idx < size; idx++) {
-        middle_ptr[idx] = sma_ptr[idx];
-        lower_ptr[idx] = sma_ptr[idx] - (deviation * std_ptr[idx]);
-        upper_ptr[idx] = sma_ptr[idx] + (deviation * std_ptr[idx]);
-    }
+        const int periods, const int deviation, const int axis, const py::object out) {
+
+    std::vector<py::array_t<T>> result = panel_calc<T>({prices}, 3, axis, out, 
+        [periods, deviation](const T * const *in, T * const *out, const int size) {
+            bbands_kernel(in[0], out[0], out[1], out[2], (T *) nullptr, (T *) nullptr,
+                size, periods, deviation);
+        });
 
-    return std::make_tuple(upper, middle, lower);
+    return std::make_tuple(result[0], result[1], result[2]);
 }
 
 /*
- * Implementation of KC.
- *
- * Math: middle = EMA(periods).
-         top = middle + (deviation * ATR(periods_atr))
-         bottom = middle - (deviation * ATR(periods_atr))
-    
-    @param prices (vector<double>): Vector with prices.
-    @param periods (int): Number of periods.
-    @param periods_atr (int): Number of periods for the atr calculations.
-    @param deviation (int): Number of deviations from ema.
-        Multiplied with atr.
+ *  Bollinger Bands with the outputs chosen by name, from 'upper', 'middle',
+ *  'lower', 'percent_b' and 'bandwidth', returned in the order given. Only
+ *  the requested outputs are allocated and written.
  */
+template <typename T>
+std::vector<py::array_t<T>> bbands_outputs_calc(const py::array_t<T> prices,
+        const int periods, const int deviation, const std::vector<std::string> outputs,
+        const int axis, const py::object out) {
+
+    const std::vector<std::string> names = {"upper", "middle", "lower", "percent_b", "bandwidth"};
+
+    if (outputs.empty()) {
+        throw py::value_error("Param 'outputs' needs to contain at least one name");
+    }
+
+    // Position of each output in the result, or -1 if not requested.
+    std::vector<int> positions(names.size(), -1);
+    for (size_t ii = 0; ii < outputs.size(); ++ii) {
+        const auto name = std::find(names.begin(), names.end(), outputs[ii]);
+        if (name == names.end() || positions[name - names.begin()] != -1) {
+            throw py::value_error("Param 'outputs' needs to contain distinct names of "
+                    "'upper', 'middle', 'lower', 'percent_b' and 'bandwidth'");
+        }
+
+        positions[name - names.begin()] = ii;
+    }
+
+    return panel_calc<T>({prices}, outputs.size(), axis, out, 
+        [positions, periods, deviation](const T * const *in, T * const *out, const int size) {
+            T *ptrs[5];
+            for (int ii = 0; ii < 5; ++ii) {
+                ptrs[ii] = positions[ii] == -1 ? nullptr : out[positions[ii]];
+            }
+
+            bbands_kernel(in[0], ptrs[0], ptrs[1], ptrs[2], ptrs[3], ptrs[4],
+                size, periods, deviation);
+        });
+}
+
+
 template <typename T>
 std::tuple<py::array_t<T>, py::array_t<T>, py::array_t<T>>
     kc_calc(const py::array_t<T> prices, const py::array_t<T> highs, 
             const py::array_t<T> lows, const int period, const int period_atr, 
-            const int deviation) {
-
-        py::buffer_info prices_buf = prices.request();
-        const int size = prices_buf.shape[0];
-        
-        auto lower = py::array_t<T>(prices_buf.size);
-        auto upper = py::array_t<T>(prices_buf.size);
-        auto *lower_ptr = (T *) lower.request().ptr;
-        auto *upper_ptr = (T *) upper.request().ptr;
-    
-        init_nan(lower_ptr, size);
-        init_nan(upper_ptr, size);
-
-        auto middle = ema_calc(prices, period);
-        auto atr = atr_calc(prices, highs, lows, period_atr);
-        auto *middle_ptr = (T *) middle.request().ptr;
-        auto *atr_ptr = (T *) atr.request().ptr;
-        
-        // If period_atr is greater than period, subtraction with NaN values
-        // will happen, however it is fine for now since it will also result in NaNs.
-        for (int idx = period; idx < size; ++idx) {
-            lower_ptr[idx] = middle_ptr[idx] - (deviation * atr_ptr[idx]);
-            upper_ptr[idx] = middle_ptr[idx] + (deviation * atr_ptr[idx]);
-        }
-        middle_ptr[period-1] = std::numeric_limits<T>::quiet_NaN();
-        return std::make_tuple(upper, middle, lower);
+            const int deviation, const int axis, const py::object out) {
+
+        std::vector<py::array_t<T>> result = panel_calc<T>({prices, highs, lows}, 3, axis, out, 
+            [period, period_atr, deviation](const T * const *in, T * const *out, const int size) {
+                kc_kernel(in[0], in[1], in[2], out[0], out[1], out[2], size,
+                    period, period_atr, deviation);
+            });
+
+        return std::make_tuple(result[0], result[1], result[2]);
 }   
 
 /*
- * Implementation of ATR.
+ * Implementation of TRANGE.
  *
-    Consists of taking the exponential average (standard 14 days) of the True Range.
-    True Range vector will have one day's NaN since starting value should
-    compare to yesterday's closing price.
-
-    Math: True range-value is the greatest of the following.
-        1. Today's high minus todays's low.
-        2. Absolute value of today's high minus yesterday's close.
-        3. Absolute value of today's low minus yesterday's close.
-
-    Observe that there exist 10 unstable periods when calculating using 10 periods,
-    since two of the conditions below includes yesterday prices, meaning the first ATR
-    can't be calcualted (since it doesn't exist any values before the first), and hence
-    one more NaN is included in the returned array.
+ * True range, see true_range.h. The first value is NaN since there is no
+ * previous close.
  */
 template <typename T>
-py::array_t<T> atr_calc(const py::array_t<T> prices, 
+py::array_t<T> trange_calc(const py::array_t<T> prices, 
         const py::array_t<T> highs, const py::array_t<T> lows, 
-        const int periods) {
-
-    py::buffer_info prices_buf = prices.request();
-    auto *prices_ptr = (T *) prices_buf.ptr;
-    const int size = prices_buf.shape[0];
-
-    auto *highs_ptr = (T *) highs.request().ptr;
-    auto *lows_ptr = (T *) lows.request().ptr;
-    
-    auto tr = py::array_t<T>(prices_buf.size);
-    auto atr = py::array_t<T>(prices_buf.size);
-    auto *tr_ptr = (T *) tr.request().ptr;
-    auto *atr_ptr = (T *) atr.request().ptr;
-    
-    init_nan(tr_ptr, size);
-    init_nan(atr_ptr, size);
-
-    for (int idx = 1; idx < size; ++idx) {
-        T condition1 = highs_ptr[idx] - lows_ptr[idx];
-        T condition2 = abs(highs_ptr[idx] - prices_ptr[idx-1]);
-        T condition3 = abs(lows_ptr[idx] - prices_ptr[idx-1]);
-        tr_ptr[idx] = std::max({condition1, condition2, condition3});
-
-        if (idx == periods) {
-            // First ATR-value is a simple mean from the TR-values.
-            atr_ptr[idx] = std::accumulate(tr_ptr + 1, tr_ptr + periods + 1, 0.0) / periods;
-        }
-        
-        // Subsequent ATR-values uses a smoothing average of the TR-values
-        if (idx > periods) {
-            atr_ptr[idx] = (atr_ptr[idx-1] * (periods - 1) + tr_ptr[idx]) / periods;
-        }
-    }
-
-    return atr;
+        const int axis, const py::object out) {
+    return panel_calc<T>({prices, highs, lows}, 1, axis, out, 
+        [](const T * const *in, T * const *out, const int size) {
+            true_range_kernel(in[0], in[1], in[2], out[0], size);
+        })[0];
 }
 
-/*
- * Implementation of CV.
- *
-    Math: True range-value is the greatest of the following.
 
-    @param highs (vector<double>): Vector with high prices.
-    @param lwos (vector<double>): Vector with low prices.
-    @param period (int): Number of periods.
-    @param smoothing_period (int): Number of periods for the smoothing of the ema.
+template <typename T>
+py::array_t<T> atr_calc(const py::array_t<T> prices, 
+        const py::array_t<T> highs, const py::array_t<T> lows, 
+        const int periods, const int axis, const py::object out) {
+    return panel_calc<T>({prices, highs, lows}, 1, axis, out, 
+        [periods](const T * const *in, T * const *out, const int size) {
+            atr_kernel(in[0], in[1], in[2], out[0], size, periods);
+        },
+        [periods](const T * const *in, const std::ptrdiff_t *in_step, 
+                T * const *out, const std::ptrdiff_t *out_step, const int size) {
+            return atr_lanes_kernel(in[0], in[1], in[2], in_step, out[0], out_step[0],
+                size, periods);
+        })[0];
+}
 
- */
 
 template <typename T>
 py::array_t<T> cv_calc(const py::array_t<T> highs,
-    const py::array_t<T> lows, const int period, const int smoothing_period) {
-
-    //std::vector<double> diff(highs.size());
-    //std::vector<double> cv(highs.size(), std::numeric_limits<double>::quiet_NaN());
-    
-    py::buffer_info highs_buf = highs.request();
-    const int size = highs_buf.shape[0];
-    auto *highs_ptr = (T *) highs_buf.ptr;
-    auto *lows_ptr = (T *) lows.request().ptr;
-    
-    auto diff = py::array_t<T>(highs_buf.size);
-    auto *diff_ptr = (T*) diff.request().ptr;
-
-    // Get difference between high and lows.
-    std::transform(highs_ptr, highs_ptr+size, lows_ptr, diff_ptr,
-        std::minus<T>());
-
-    // Calculate the ema for the differences.
-    auto ema = ema_calc(diff, period);
-    auto *ema_ptr = (T *) ema.request().ptr;
-        
-    auto cv = py::array_t<T>(highs_buf.size);
-    auto *cv_ptr = (T *) cv.request().ptr;
-    init_nan(cv_ptr, size);
-
-    for (int idx = period + smoothing_period - 2; idx < size; ++idx) {
-        cv_ptr[idx] = ((ema_ptr[idx] - ema_ptr[idx - smoothing_period + 1]) / (ema_ptr[idx - smoothing_period + 1])) * 100;
-    }
-    
-    return cv;
+    const py::array_t<T> lows, const int period, const int smoothing_period,
+    const int axis, const py::object out) {
+    return panel_calc<T>({highs, lows}, 1, axis, out, 
+        [period, smoothing_period](const T * const *in, T * const *out, const int size) {
+            cv_kernel(in[0], in[1], out[0], size, period, smoothing_period);
+        })[0];
 }
 
 
-
-// TEST SSE OPTIMIZATION
 /*
-std::vector<double> sse_calc(std::vector<double> prices, std::vector<double> highs,
-        std::vector<double> lows) {
-
-    prices.insert(prices.begin(), 0.0);
-    prices.erase(prices.end() - 1);
-    int periods = 14;
-    std::vector<double> tr(prices.size());
-
-    // Used for taking absolute value.
-    __m128 abs = _mm_set_ps1(-0.0);
-    for (int i = 0; i < prices.size(); i += 2) {
-
-        __m128 price = _mm_load_pd(&prices[i]); 
-        __m128 high = _mm_load_pd(&highs[i]); 
-        __m128 low = _mm_load_pd(&lows[i]); 
-
-        __m128 sub_high_low = _mm_sub_pd(high, low);
-        __m128 sub_high_price = _mm_andnot_pd(abs, _mm_sub_pd(high, price));
-        __m128 sub_low_price = _mm_andnot_pd(abs, _mm_sub_pd(low, price));
-        __m128 first_max = _mm_max_pd(sub_high_low, sub_high_price);
-        __m128 last_max = _mm_max_pd(first_max, sub_low_price);
-        _mm_store_pd(&tr[i], last_max);
-    }
-
-    tr[0] = highs[0] - lows[0];
-    return ema_calc(tr, periods, true);
-}
-
-*/
-
-
-PYBIND11_MODULE(_volatility, m) {
+ *  Bindings of the _volatility submodule, added to the _qufilab extension in
+ *  qufilab/_qufilab.cc.
+ */
+void init_volatility(py::module &m) {
 
     m.def("bbands_calc", &bbands_calc<double>, "Bollinger bands calculations");
     m.def("bbands_calc", &bbands_calc<float>, "Bollinger bands calculations");
 
+    m.def("bbands_outputs_calc", &bbands_outputs_calc<double>, "Bollinger bands calculations");
+    m.def("bbands_outputs_calc", &bbands_outputs_calc<float>, "Bollinger bands calculations");
+
     m.def("kc_calc", &kc_calc<double>, "Keltner Channels");
     m.def("kc_calc", &kc_calc<float>, "Keltner Channels");
 
+    m.def("trange_calc", &trange_calc<double>, "True Range");
+    m.def("trange_calc", &trange_calc<float>, "True Range");
+
     m.def("atr_calc", &atr_calc<double>, "Average True Range calculations");
     m.def("atr_calc", &atr_calc<float>, "Average True Range calculations");
 
     m.def("cv_calc", &cv_calc<double>, "Chaikin Volatility");
     m.def("cv_calc", &cv_calc<float>, "Chaikin Volatility");
 
-    //m.def("sse_calc", &sse_calc, "");
-
+    simd_register("atr");
+    simd_register("kc");
+    simd_register("trange");
+    m.def("_simd_kernels", &simd_kernels, "SIMD level of the kernels");
 }
@@ -3,30 +3,52 @@
 
 #include <iostream>
 #include <vector>
+#include <cstddef>
+#include <string>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 
+#include "panel.h"
+#include "../core/volatility.h"
+
 namespace py = pybind11;
 
+/*
+ *  Arrays can be 1D or 2D, see panel.h for the meaning of axis and out.
+ */
 template <typename T>
 std::tuple<py::array_t<T>, py::array_t<T>, py::array_t<T>>
     bbands_calc(const py::array_t<T> prices, const int periods, 
-            const int deviations);
+            const int deviations, const int axis = 0, const py::object out = py::none());
+
+template <typename T>
+std::vector<py::array_t<T>> bbands_outputs_calc(const py::array_t<T> prices,
+        const int periods, const int deviation, const std::vector<std::string> outputs,
+        const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 std::tuple<py::array_t<T>, py::array_t<T>, py::array_t<T>>
     kc_calc(const py::array_t<T> prices,
             const py::array_t<T> highs, const py::array_t<T> lows,
-            const int period, const int period_atr, const int deviation);
+            const int period, const int period_atr, const int deviation,
+            const int axis = 0, const py::object out = py::none());
+
+template <typename T>
+py::array_t<T> trange_calc(const py::array_t<T> prices,
+        const py::array_t<T> highs, const py::array_t<T> lows,
+        const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> atr_calc(const py::array_t<T> prices,
         const py::array_t<T> highs, const py::array_t<T>
-        lows, const int periods);
+        lows, const int periods, const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> cv_calc(const py::array_t<T> highs,
         const py::array_t<T> lows, const int period,
-        const int smoothing_perid);
+        const int smoothing_perid, const int axis = 0, const py::object out = py::none());
+
+// Adds the bindings of the module to the submodule m.
+void init_volatility(py::module &m);
 
 #endif
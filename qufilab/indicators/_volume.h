@@ -6,17 +6,25 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 
+#include "panel.h"
+#include "../core/volume.h"
+
 namespace py = pybind11;
 
+/*
+ *  Arrays can be 1D or 2D, see panel.h for the meaning of axis and out.
+ */
 template <typename T>
 py::array_t<T> acdi_calc(const py::array_t<T> price,
         const py::array_t<T> highs, 
         const py::array_t<T> lows,
-        const py::array_t<T> volumes);
+        const py::array_t<T> volumes,
+        const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> obv_calc(const py::array_t<T> price,
-        const py::array_t<T> volumes);
+        const py::array_t<T> volumes,
+        const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> cmf_calc(
@@ -24,23 +32,30 @@ py::array_t<T> cmf_calc(
         const py::array_t<T> highs, 
         const py::array_t<T> lows,
         const py::array_t<T> volumes,
-        const int periods);
+        const int periods,
+        const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> ci_calc(
         const py::array_t<T> price,
         const py::array_t<T> highs, 
         const py::array_t<T> lows,
-        const py::array_t<T> volumes);
+        const py::array_t<T> volumes,
+        const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> pvi_calc(
         const py::array_t<T> price,
-        const py::array_t<T> volumes);
+        const py::array_t<T> volumes,
+        const int axis = 0, const py::object out = py::none());
 
 template <typename T>
 py::array_t<T> nvi_calc(
         const py::array_t<T> price,
-        const py::array_t<T> volumes);
+        const py::array_t<T> volumes,
+        const int axis = 0, const py::object out = py::none());
+
+// Adds the bindings of the module to the submodule m.
+void init_volume(py::module &m);
 
 #endif
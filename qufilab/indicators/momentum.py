@@ -10,7 +10,7 @@ import numpy as np
 
 from qufilab.indicators._momentum import *
 
-def rsi(price, period, rsi_type = "smoothed"):
+def rsi(price, period, rsi_type = "smoothed", axis = 0, out = None):
     """
     .. Relative strength index
     
@@ -20,18 +20,26 @@ def rsi(price, period, rsi_type = "smoothed"):
         Array of type float64 or float32 containing the data to calculate rsi from.
     period : `int`
         Number of periods to be used.
-    rsi_type : {'smoothed', 'standard'}, optional
+    rsi_type : {'smoothed', 'standard', 'cutler'}, optional
         Specify what kind of averaging should be used for calculating the average gain/
-        average loss. Standard is the Wilder's smoothing.
-    
+        average loss. Smoothed is Wilder's smoothing. Standard is the simple average
+        of the last `period` gains/losses, also known as Cutler's RSI, which
+        'cutler' is an alias for. Defaults to 'smoothed'.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
+
     Returns
     -------
     `ndarray`
         Returns a numpy ndarray with type float64 or float32.
     """
-    return rsi_calc(price, period, rsi_type.lower())
+    return rsi_calc(price, period, rsi_type.lower(), axis, out)
 
-def macd(price):
+def macd(price, axis = 0, out = None):
     """
     .. MACD
 
@@ -39,6 +47,13 @@ def macd(price):
     ----------
     price : `ndarray`
         Array of type float64 or float32 containing the prices to calculate macd from.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `tuple` of `ndarray`, optional
+        Arrays to write the results to instead of allocating new ones, one
+        per returned array, with the same shape and dtype as the input.
+        Defaults to None.
 
     Returns
     -------
@@ -47,9 +62,9 @@ def macd(price):
     signal : `ndarray`
         Array of type float64 or float32 containing the signal values.
     """
-    return macd_calc(price)
+    return macd_calc(price, axis, out)
 
-def willr(close, high, low, period):
+def willr(close, high, low, period, axis = 0, out = None):
     """
     .. William's R
 
@@ -63,15 +78,21 @@ def willr(close, high, low, period):
         Array of type float64 or float32 containing the low prices.
     period : `int`
         Number of periods to be used.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
     `ndarray`
         Array of type float64 or float32 containing the william's r values.
     """
-    return willr_calc(close, high, low, period)
+    return willr_calc(close, high, low, period, axis, out)
 
-def roc(price, period):
+def roc(price, period, axis = 0, out = None):
     """
     .. Price Rate of Change
 
@@ -81,6 +102,12 @@ def roc(price, period):
         Array of type float64 or float32 containing price values.
     period : `int`
         Number of periods to be used.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -88,9 +115,9 @@ def roc(price, period):
         Array of type float64 or float32 containing the calculated rate
         of change values.
     """
-    return roc_calc(price, period)
+    return roc_calc(price, period, axis, out)
 
-def vpt(price, volume):
+def vpt(price, volume, axis = 0, out = None):
     """
     .. Volume Price Trend
 
@@ -100,6 +127,12 @@ def vpt(price, volume):
         Array of type float64 or float32 containing price values.
     volume : `ndarray`
         Array of type float64 or float32 containing volume values.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -107,9 +140,9 @@ def vpt(price, volume):
         Array of type float64 or float32 containing the calculated volume
         price trend values.
     """
-    return vpt_calc(price, volume)
+    return vpt_calc(price, volume, axis, out)
 
-def mi(price, period):
+def mi(price, period, axis = 0, out = None):
     """
     .. Momentum Indicator
 
@@ -119,6 +152,12 @@ def mi(price, period):
         Array of type float64 or float32 containing price values.
     period : `int`
         Number of periods to be used.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -126,9 +165,9 @@ def mi(price, period):
         Array of type float64 or float32 containing the calculated momentum
         indicator values.
     """
-    return mi_calc(price, period)
+    return mi_calc(price, period, axis, out)
 
-def apo(price, period_slow = 26, period_fast = 12, ma = "sma"):
+def apo(price, period_slow = 26, period_fast = 12, ma = "sma", axis = 0, out = None):
     """
     .. Absolute Price Oscillator
 
@@ -145,6 +184,12 @@ def apo(price, period_slow = 26, period_fast = 12, ma = "sma"):
     ma : {'sma', 'ema'}, optional
         Type of moving average to be used. 
         Default to 'sma'
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -155,9 +200,9 @@ def apo(price, period_slow = 26, period_fast = 12, ma = "sma"):
     if ma.lower() not in ["sma", "ema"]:
         raise ValueError("param 'ma' needs to be 'ema' or 'sma'")
 
-    return apo_calc(price, period_slow, period_fast, ma.lower())
+    return apo_calc(price, period_slow, period_fast, ma.lower(), axis, out)
 
-def bop(high, low, open_, close):
+def bop(high, low, open_, close, axis = 0, out = None):
     """
     .. Balance of Power
 
@@ -171,6 +216,12 @@ def bop(high, low, open_, close):
         Array of type float64 or float32 containing open prices.
     close : `ndarray`
         Array of type float64 or float32 containing closing prices.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -178,9 +229,9 @@ def bop(high, low, open_, close):
         Array of type float64 or float32 containing the calculated 
         balance of power values.
     """
-    return bop_calc(high, low, open_, close)
+    return bop_calc(high, low, open_, close, axis, out)
 
-def cmo(close, period):
+def cmo(close, period, axis = 0, out = None):
     """
     .. Chande Momentum Indicator
 
@@ -190,6 +241,12 @@ def cmo(close, period):
         Array of type float64 or float32 containing closing prices.
     period : `int`
         Number of periods to be used.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -197,9 +254,9 @@ def cmo(close, period):
         Array of type float64 or float32 containing the calculated chande
         momentum values.
     """
-    return cmo_calc(close, period)
+    return cmo_calc(close, period, axis, out)
 
-def mfi(high, low, close, volume, period):
+def mfi(high, low, close, volume, period, axis = 0, out = None):
     """
     .. Money Flow Index
 
@@ -215,6 +272,12 @@ def mfi(high, low, close, volume, period):
         Array of type float64 or float32 containing volume values.
     period : `int`
         Number of periods to be used.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -222,9 +285,9 @@ def mfi(high, low, close, volume, period):
         Array of type float64 or float32 containing the calculated money
         flow index values.
     """
-    return mfi_calc(high, low, close, volume, period)
+    return mfi_calc(high, low, close, volume, period, axis, out)
 
-def ppo(price, period_fast = 12, period_slow = 26, ma = "ema"):
+def ppo(price, period_fast = 12, period_slow = 26, ma = "ema", axis = 0, out = None):
     """
     .. Percentage Price Oscillator
     
@@ -241,6 +304,12 @@ def ppo(price, period_fast = 12, period_slow = 26, ma = "ema"):
     ma : {'ema', 'sma'}, optional
         Type of moving average to be used. 
         Default to 'ema'
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -251,7 +320,7 @@ def ppo(price, period_fast = 12, period_slow = 26, ma = "ema"):
     if ma.lower() not in ["sma", "ema"]:
         raise ValueError("Param 'ma' needs to be 'sma' or 'ema'")
 
-    return ppo_calc(price, period_fast, period_slow, ma.lower())
+    return ppo_calc(price, period_fast, period_slow, ma.lower(), axis, out)
 
 #def stochastic(close, high, low, mode = "fast", period_k = 10, method = "ema"):
 #    """
@@ -285,7 +354,7 @@ def ppo(price, period_fast = 12, period_slow = 26, ma = "ema"):
 #    return stochastic_calc(close, high, low, mode, period_k, method)
 
 
-def cci(close, high, low, period = 20):
+def cci(close, high, low, period = 20, axis = 0, out = None):
     """
     .. Commodity Channel Index
 
@@ -300,6 +369,12 @@ def cci(close, high, low, period = 20):
     period : `int`, optional
         Number of periods to be used.
         Defaults to 20.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -307,9 +382,9 @@ def cci(close, high, low, period = 20):
         Array of type float64 or float32 containing the calculated commodity
         channel index values.
     """
-    return cci_calc(close, high, low, period)
+    return cci_calc(close, high, low, period, axis, out)
 
-def aroon(high, low, period = 20):
+def aroon(high, low, period = 20, axis = 0, out = None):
     """
     .. Aroon Indicator
     
@@ -322,6 +397,12 @@ def aroon(high, low, period = 20):
     period : `int`, optional
         Number of periods to be used.
         Defaults to 20.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -329,7 +410,7 @@ def aroon(high, low, period = 20):
         Array of type float64 or float32 containing the calculated
         aroon indicator values.
     """
-    return aroon_calc(high, low, period)
+    return aroon_calc(high, low, period, axis, out)
 
 #def tsi(close, period = 25, period_double = 13):
 #    return tsi_calc(close, period, period_double)
@@ -0,0 +1,436 @@
+#ifndef INDICATOR_PANEL_H
+#define INDICATOR_PANEL_H
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+#include <pybind11/pybind11.h>
+#include <pybind11/numpy.h>
+
+#include "../core/util.h"
+
+namespace py = pybind11;
+
+/*
+ *  Handling of 1D and 2D (panel) input.
+ *
+ *  All indicators are implemented as kernels working on one series at a time.
+ *  A 2D array is treated as several independent series, with time running
+ *  along the given axis:
+ *      axis = 0: shape (n_bars, n_series), i.e. one column per symbol.
+ *      axis = 1: shape (n_series, n_bars), i.e. one row per symbol.
+ *  A 1D array is a single series and the axis is ignored.
+ *
+ *  panel_calc splits the inputs into series, calls the kernel for each series
+ *  and returns n_outputs arrays with the same shape as the inputs. The series
+ *  are calculated in parallel. A series that isn't contiguous in memory is
+ *  copied into a per-thread buffer before the kernel is called, and outputs
+ *  are copied back in the same way.
+ *
+ *  The kernel is called as kernel(inputs, outputs, size), where inputs and
+ *  outputs are arrays with pointers to the current series and size is the
+ *  number of bars. Kernels write every value of the output, NaN is only
+ *  written to the warm-up region, so the outputs don't need to be cleared
+ *  in advance. The inputs and outputs are set up before the kernels are
+ *  called, and the kernels run without the GIL, so other python threads
+ *  can run at the same time. Kernels must therefore not use python objects.
+ *
+ *  The outputs can be supplied by the caller with out, which is None, an
+ *  array (one output) or a tuple of arrays (several outputs). Such arrays
+ *  need to have the same shape and dtype as the inputs, and are returned
+ *  instead of newly allocated arrays.
+ */
+
+template <typename T>
+struct Panel {
+    int size;
+    int n_series;
+    int n_inputs;
+    int n_outputs;
+
+    // Steps (in elements) between two bars and between two series.
+    std::vector<const T *> inputs_base;
+    std::vector<std::ptrdiff_t> inputs_step;
+    std::vector<std::ptrdiff_t> inputs_series_step;
+
+    std::vector<py::array_t<T>> outputs;
+    std::vector<T *> outputs_base;
+    std::vector<std::ptrdiff_t> outputs_step;
+    std::vector<std::ptrdiff_t> outputs_series_step;
+
+    // Caller supplied outputs that overlap an input are calculated into
+    // outputs and copied to overlapping afterwards.
+    std::vector<py::array_t<T>> overlapping;
+};
+
+/*
+ *  Returns out if it is an array of type T with the given shape that can be
+ *  written to, and a new array if out is None. Callers that index the
+ *  array directly can require it to be C-contiguous.
+ */
+template <typename T>
+py::array_t<T> output_array(const py::object &out, const std::vector<py::ssize_t> &shape,
+        const bool contiguous = false) {
+
+    if (out.is_none()) {
+        return py::array_t<T>(shape);
+    }
+
+    if (!py::isinstance<py::array_t<T>>(out)) {
+        throw py::type_error("Param 'out' needs to be an array with the same dtype as the input");
+    }
+
+    py::array_t<T> array = py::reinterpret_borrow<py::array_t<T>>(out);
+    if (!array.writeable()) {
+        throw py::value_error("Param 'out' needs to be writeable");
+    }
+
+    py::buffer_info buf = array.request();
+    if (buf.shape != shape) {
+        throw py::value_error("Param 'out' needs to have the same shape as the result");
+    }
+
+    py::ssize_t stride = sizeof(T);
+    for (int dim = buf.ndim - 1; dim >= 0 && contiguous; --dim) {
+        if (buf.shape[dim] > 1 && buf.strides[dim] != stride) {
+            throw py::value_error("Param 'out' needs to be C-contiguous");
+        }
+
+        stride *= buf.shape[dim];
+    }
+
+    return array;
+}
+
+/*
+ *  Array for bindings that index a single series directly instead of going
+ *  through panel_calc. Strided views and other dtypes are copied into a
+ *  C-contiguous array of type T when the function is called.
+ */
+template <typename T>
+using ContiguousArray = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+/*
+ *  Buffer of a ContiguousArray, which needs to be 1D.
+ */
+template <typename T>
+py::buffer_info series_request(const ContiguousArray<T> &series) {
+    py::buffer_info buf = series.request();
+    if (buf.ndim != 1) {
+        throw py::value_error("Only 1D arrays are supported");
+    }
+
+    return buf;
+}
+
+/*
+ *  Range of bytes spanned by an array.
+ */
+inline std::pair<const char *, const char *> memory_range(const py::buffer_info &buf) {
+    const char *low = (const char *) buf.ptr;
+    const char *high = low + buf.itemsize;
+    for (int dim = 0; dim < buf.ndim; ++dim) {
+        if (buf.shape[dim] == 0) {
+            return std::make_pair(low, low);
+        }
+
+        const std::ptrdiff_t extent = (buf.shape[dim] - 1) * buf.strides[dim];
+        if (extent < 0) {
+            low += extent;
+        }
+
+        else {
+            high += extent;
+        }
+    }
+
+    return std::make_pair(low, high);
+}
+
+/*
+ *  True if the memory spanned by the two arrays overlaps.
+ */
+inline bool memory_overlaps(const py::buffer_info &a, const py::buffer_info &b) {
+    std::pair<const char *, const char *> range_a = memory_range(a);
+    std::pair<const char *, const char *> range_b = memory_range(b);
+    return range_a.first < range_b.second && range_b.first < range_a.second;
+}
+
+/*
+ *  Validates the inputs and sets up the outputs, see output_array.
+ */
+template <typename T>
+Panel<T> panel_init(const std::vector<py::array_t<T>> &inputs,
+        const int n_outputs, const int axis, const py::object &out) {
+
+    Panel<T> panel;
+    panel.n_inputs = inputs.size();
+    panel.n_outputs = n_outputs;
+
+    std::vector<py::buffer_info> inputs_buf;
+    for (int ii = 0; ii < panel.n_inputs; ++ii) {
+        inputs_buf.push_back(inputs[ii].request());
+    }
+
+    const py::buffer_info &first_buf = inputs_buf[0];
+    if (first_buf.ndim != 1 && first_buf.ndim != 2) {
+        throw py::value_error("Only 1D and 2D arrays are supported");
+    }
+
+    if (axis != 0 && axis != 1) {
+        throw py::value_error("Param 'axis' needs to be 0 or 1");
+    }
+
+    for (int ii = 1; ii < panel.n_inputs; ++ii) {
+        if (inputs_buf[ii].shape != first_buf.shape) {
+            throw py::value_error("All arrays need to have the same shape");
+        }
+    }
+
+    const bool is_panel = first_buf.ndim == 2;
+    const int time_axis = is_panel ? axis : 0;
+    panel.size = first_buf.shape[time_axis];
+    panel.n_series = is_panel ? first_buf.shape[1 - time_axis] : 1;
+
+    for (int ii = 0; ii < panel.n_inputs; ++ii) {
+        panel.inputs_base.push_back((const T *) inputs_buf[ii].ptr);
+        panel.inputs_step.push_back(inputs_buf[ii].strides[time_axis] / (py::ssize_t) sizeof(T));
+        panel.inputs_series_step.push_back(is_panel ?
+            inputs_buf[ii].strides[1 - time_axis] / (py::ssize_t) sizeof(T) : 0);
+    }
+
+    std::vector<py::object> out_arrays(n_outputs, py::none());
+    if (!out.is_none() && n_outputs == 1) {
+        out_arrays[0] = out;
+    }
+
+    else if (!out.is_none()) {
+        if (!py::isinstance<py::tuple>(out) && !py::isinstance<py::list>(out)) {
+            throw py::type_error("Param 'out' needs to be a tuple of arrays");
+        }
+
+        py::sequence out_seq = py::reinterpret_borrow<py::sequence>(out);
+        if ((int) out_seq.size() != n_outputs) {
+            throw py::value_error("Param 'out' needs to have one array per output");
+        }
+
+        for (int ii = 0; ii < n_outputs; ++ii) {
+            out_arrays[ii] = out_seq[ii];
+        }
+    }
+
+    for (int ii = 0; ii < n_outputs; ++ii) {
+        py::array_t<T> output = output_array<T>(out_arrays[ii], first_buf.shape);
+        py::buffer_info output_buf = output.request(true);
+
+        // Writing into an array that is also read from would change the input
+        // during the calculation.
+        bool overlaps = false;
+        for (int jj = 0; jj < panel.n_inputs && !out_arrays[ii].is_none(); ++jj) {
+            overlaps = overlaps || memory_overlaps(output_buf, inputs_buf[jj]);
+        }
+
+        if (overlaps) {
+            panel.overlapping.push_back(output);
+            output = py::array_t<T>(first_buf.shape);
+            output_buf = output.request(true);
+        }
+
+        else {
+            panel.overlapping.push_back(py::array_t<T>());
+        }
+
+        panel.outputs.push_back(output);
+        panel.outputs_base.push_back((T *) output_buf.ptr);
+        panel.outputs_step.push_back(output_buf.strides[time_axis] / (py::ssize_t) sizeof(T));
+        panel.outputs_series_step.push_back(is_panel ?
+            output_buf.strides[1 - time_axis] / (py::ssize_t) sizeof(T) : 0);
+    }
+
+    return panel;
+}
+
+/*
+ *  Copies outputs into the caller supplied arrays that overlapped an input,
+ *  and returns the arrays to give back to the caller.
+ */
+template <typename T>
+std::vector<py::array_t<T>> panel_finish(Panel<T> &panel) {
+    for (int ii = 0; ii < panel.n_outputs; ++ii) {
+        if (panel.overlapping[ii].size() == 0) {
+            continue;
+        }
+
+        py::buffer_info src_buf = panel.outputs[ii].request();
+        py::buffer_info dst_buf = panel.overlapping[ii].request(true);
+
+        const bool is_panel = src_buf.ndim == 2;
+        const py::ssize_t rows = is_panel ? src_buf.shape[0] : 1;
+        const py::ssize_t cols = src_buf.shape[src_buf.ndim - 1];
+        const py::ssize_t src_row = is_panel ? src_buf.strides[0] : 0;
+        const py::ssize_t dst_row = is_panel ? dst_buf.strides[0] : 0;
+        const py::ssize_t src_col = src_buf.strides[src_buf.ndim - 1];
+        const py::ssize_t dst_col = dst_buf.strides[dst_buf.ndim - 1];
+
+        for (py::ssize_t row = 0; row < rows; ++row) {
+            for (py::ssize_t col = 0; col < cols; ++col) {
+                *(T *) ((char *) dst_buf.ptr + row * dst_row + col * dst_col) =
+                    *(const T *) ((const char *) src_buf.ptr + row * src_row + col * src_col);
+            }
+        }
+
+        panel.outputs[ii] = panel.overlapping[ii];
+    }
+
+    return panel.outputs;
+}
+
+/*
+ *  Calculates a single series of the panel with the per series kernel.
+ */
+template <typename T, typename Kernel>
+void panel_series(const Panel<T> &panel, const int series, std::vector<T> &buffer,
+        std::vector<const T *> &series_in, std::vector<T *> &series_out, Kernel &kernel) {
+
+    const int size = panel.size;
+    const size_t buffer_size = (size_t) (panel.n_inputs + panel.n_outputs) * size;
+
+    for (int ii = 0; ii < panel.n_inputs; ++ii) {
+        const T *src = panel.inputs_base[ii] + series * panel.inputs_series_step[ii];
+        if (panel.inputs_step[ii] == 1) {
+            series_in[ii] = src;
+            continue;
+        }
+
+        buffer.resize(buffer_size);
+        T *dst = buffer.data() + (size_t) ii * size;
+        for (int idx = 0; idx < size; ++idx) {
+            dst[idx] = src[idx * panel.inputs_step[ii]];
+        }
+        series_in[ii] = dst;
+    }
+
+    for (int ii = 0; ii < panel.n_outputs; ++ii) {
+        if (panel.outputs_step[ii] == 1) {
+            series_out[ii] = panel.outputs_base[ii] + series * panel.outputs_series_step[ii];
+        }
+
+        else {
+            buffer.resize(buffer_size);
+            series_out[ii] = buffer.data() + (size_t) (panel.n_inputs + ii) * size;
+        }
+    }
+
+    kernel(series_in.data(), series_out.data(), size);
+
+    for (int ii = 0; ii < panel.n_outputs; ++ii) {
+        if (panel.outputs_step[ii] != 1) {
+            T *dst = panel.outputs_base[ii] + series * panel.outputs_series_step[ii];
+            for (int idx = 0; idx < size; ++idx) {
+                dst[idx * panel.outputs_step[ii]] = series_out[ii][idx];
+            }
+        }
+    }
+}
+
+template <typename T, typename Kernel>
+std::vector<py::array_t<T>> panel_calc(const std::vector<py::array_t<T>> &inputs,
+        const int n_outputs, const int axis, const py::object &out, Kernel kernel) {
+
+    Panel<T> panel = panel_init(inputs, n_outputs, axis, out);
+
+    {
+        py::gil_scoped_release release;
+
+        #pragma omp parallel if (panel.n_series > 1)
+        {
+            std::vector<T> buffer;
+            std::vector<const T *> series_in(panel.n_inputs);
+            std::vector<T *> series_out(panel.n_outputs);
+
+            #pragma omp for schedule(dynamic)
+            for (int series = 0; series < panel.n_series; ++series) {
+                panel_series(panel, series, buffer, series_in, series_out, kernel);
+            }
+        }
+    }
+
+    return panel_finish(panel);
+}
+
+/*
+ *  Same as above, but for recurrences in time (ema, smma, ...) that can't be
+ *  vectorized along a single series. If the series are next to each other in
+ *  memory, i.e. a (n_bars, n_series) array, PANEL_LANES series are stepped
+ *  through time together by the lanes kernel, so that the compiler can keep
+ *  one series per SIMD lane. The lanes kernel is called as
+ *      lanes_kernel(inputs, inputs_step, outputs, outputs_step, size),
+ *  where the pointers point at the first of the PANEL_LANES series, and
+ *  returns false if the block can't be calculated together (e.g. different
+ *  number of leading NaNs). Such blocks, and the remaining series, are
+ *  calculated one at a time with the per series kernel. The lanes kernels
+ *  step the serial recurrence, so series longer than SCAN_BLOCK bars differ
+ *  from the per series kernel by a few units in the last place, see
+ *  affine_scan in scan.h.
+ */
+template <typename T, typename Kernel, typename LanesKernel>
+std::vector<py::array_t<T>> panel_calc(const std::vector<py::array_t<T>> &inputs,
+        const int n_outputs, const int axis, const py::object &out, Kernel kernel,
+        LanesKernel lanes_kernel) {
+
+    Panel<T> panel = panel_init(inputs, n_outputs, axis, out);
+
+    bool lanes = panel.n_series >= PANEL_LANES;
+    for (int ii = 0; ii < panel.n_inputs; ++ii) {
+        lanes = lanes && panel.inputs_series_step[ii] == 1;
+    }
+
+    for (int ii = 0; ii < panel.n_outputs; ++ii) {
+        lanes = lanes && panel.outputs_series_step[ii] == 1;
+    }
+
+    const int n_blocks = lanes ? panel.n_series / PANEL_LANES : 0;
+    const int n_tasks = n_blocks + panel.n_series - n_blocks * PANEL_LANES;
+
+    {
+        py::gil_scoped_release release;
+
+        #pragma omp parallel if (n_tasks > 1)
+        {
+            std::vector<T> buffer;
+            std::vector<const T *> series_in(panel.n_inputs);
+            std::vector<T *> series_out(panel.n_outputs);
+
+            #pragma omp for schedule(dynamic)
+            for (int task = 0; task < n_tasks; ++task) {
+                if (task >= n_blocks) {
+                    const int series = n_blocks * PANEL_LANES + task - n_blocks;
+                    panel_series(panel, series, buffer, series_in, series_out, kernel);
+                    continue;
+                }
+
+                const int first = task * PANEL_LANES;
+                for (int ii = 0; ii < panel.n_inputs; ++ii) {
+                    series_in[ii] = panel.inputs_base[ii] + first;
+                }
+
+                for (int ii = 0; ii < panel.n_outputs; ++ii) {
+                    series_out[ii] = panel.outputs_base[ii] + first;
+                }
+
+                if (!lanes_kernel(series_in.data(), panel.inputs_step.data(),
+                            series_out.data(), panel.outputs_step.data(), panel.size)) {
+
+                    for (int series = first; series < first + PANEL_LANES; ++series) {
+                        panel_series(panel, series, buffer, series_in, series_out, kernel);
+                    }
+                }
+            }
+        }
+    }
+
+    return panel_finish(panel);
+}
+
+#endif
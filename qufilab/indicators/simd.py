@@ -0,0 +1,30 @@
+"""
+@ Qufilab, 2020.
+
+Python interface for the SIMD code paths of the extensions.
+
+"""
+from qufilab.indicators import _trend, _volatility, _momentum, _volume, _stat
+
+def simd_info():
+    """
+    .. SIMD code paths
+
+    Returns
+    -------
+    `dict`
+        Name of each indicator with SIMD kernels mapped to the instruction
+        set it runs with, 'scalar', 'sse2', 'avx2' or 'avx512'.
+
+    Notes
+    -----
+    The instruction set is the best one the CPU supports, selected when the
+    extensions are imported. Setting the environment variable QUFILAB_SIMD
+    to 'scalar', 'sse2' or 'avx2' before import selects a lower one, the
+    results are the same on every level.
+    """
+    info = {}
+    for module in (_trend, _volatility, _momentum, _volume, _stat):
+        info.update(module._simd_kernels())
+
+    return info
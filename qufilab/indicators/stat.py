@@ -9,7 +9,7 @@ import numpy as np
 
 from qufilab.indicators._stat import *
 
-def std(data, periods, normalize = True):
+def std(data, periods, normalize = True, axis = 0, out = None):
     """
     .. Standard Deviation
 
@@ -23,6 +23,12 @@ def std(data, periods, normalize = True):
         Specify whether to normalize the standard deviation with 
         n - 1 instead of n.
         Defaults to True.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -42,9 +48,9 @@ def std(data, periods, normalize = True):
     >>> print(sma)
     [nan nan nan ... 3.31897842 2.9632574  3.02394683]
     """
-    return std_calc(data, periods, normalize)
+    return std_calc(data, periods, normalize, axis, out)
 
-def var(data, periods, normalize = True):
+def var(data, periods, normalize = True, axis = 0, out = None):
     """
     .. Variance
 
@@ -58,6 +64,12 @@ def var(data, periods, normalize = True):
         Specify whether to normalize the standard deviation with 
         n - 1 instead of n.
         Defaults to `True`.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -77,9 +89,9 @@ def var(data, periods, normalize = True):
     >>> print(var)
     [nan nan nan ... 11.01561778  8.78089444 9.14425444]
     """
-    return var_calc(data, periods, normalize)
+    return var_calc(data, periods, normalize, axis, out)
 
-def cov(data, market, periods, normalize = True):
+def cov(data, market, periods, normalize = True, axis = 0, out = None):
     """
     .. Covariance
 
@@ -96,6 +108,12 @@ def cov(data, market, periods, normalize = True):
         Specify whether to normalize covariance with 
         n - 1 instead of n.
         Defaults to `True`.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -114,9 +132,9 @@ def cov(data, market, periods, normalize = True):
     >>> print(cov)
     [nan nan nan ... -360.37842558  -99.1077715 60.84627274]
     """
-    return cov_calc(data, market, periods, normalize)
+    return cov_calc(data, market, periods, normalize, axis, out)
 
-def beta(data, market, periods, normalize = False):
+def beta(data, market, periods, normalize = False, axis = 0, out = None):
     """
     .. Beta
 
@@ -133,6 +151,12 @@ def beta(data, market, periods, normalize = False):
         Specify whether to normalize the standard deviation calculation
         within the beta calculation with n - 1 instead of n.
         Defaults to False.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -151,9 +175,351 @@ def beta(data, market, periods, normalize = False):
     >>> print(beta)
     [nan nan nan ... 0.67027616 0.45641977 0.3169785]
     """
-    return beta_calc(data, market, periods, normalize)
+    return beta_calc(data, market, periods, normalize, axis, out)
 
-def pct_change(data, periods):
+def corr(data, market, periods, axis = 0, out = None):
+    """
+    .. Correlation
+
+    Parameters
+    ----------
+    data : `ndarray`
+        An array containing values.
+    market : `ndarray`
+        An array containing market values to be used as the comparison.
+    periods : `int`
+        Number of periods to be used.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
+
+    Returns
+    -------
+    `ndarray`
+        An array containing pearson correlation values.
+
+    Examples
+    --------
+    >>> import qufilab as ql
+    >>> import numpy as np
+    ...
+    >>> # Load sample dataframe.
+    >>> df = ql.load_sample('MSFT')
+    >>> df_market = ql.load_sample('DJI')
+    >>> corr = ql.corr(df['close'], df_market['close'], periods = 10)
+    """
+    return corr_calc(data, market, periods, axis, out)
+
+def alpha(data, market, periods, normalize = False, axis = 0, out = None):
+    """
+    .. Alpha
+
+    Alpha is the part of the mean percentage change of data that is not
+    explained by beta, i.e. the intercept when regressing the percentage
+    changes of data on the ones of market.
+
+    Parameters
+    ----------
+    data : `ndarray`
+        An array containing values.
+    market : `ndarray`
+        An array containing market values to be used as the comparison
+        when calculating alpha.
+    periods : `int`
+        Number of periods to be used.
+    normalize : `bool`, optional
+        Specify whether to normalize the variance of the market within
+        the beta calculation with n - 1 instead of n, the same as for beta.
+        Defaults to False.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
+
+    Returns
+    -------
+    `ndarray`
+        An array containing alpha values.
+
+    Examples
+    --------
+    >>> import qufilab as ql
+    >>> import numpy as np
+    ...
+    >>> # Load sample dataframe.
+    >>> df = ql.load_sample('MSFT')
+    >>> df_market = ql.load_sample('DJI')
+    >>> alpha = ql.alpha(df['close'], df_market['close'], periods = 10)
+    """
+    return alpha_calc(data, market, periods, normalize, axis, out)
+
+def beta_alpha(data, market, periods, normalize = False, axis = 0, out = None):
+    """
+    .. Beta and Alpha
+
+    Calculates both beta and alpha in a single pass, which is cheaper than
+    calling beta and alpha separately.
+
+    Parameters
+    ----------
+    data : `ndarray`
+        An array containing values.
+    market : `ndarray`
+        An array containing market values to be used as the comparison.
+    periods : `int`
+        Number of periods to be used.
+    normalize : `bool`, optional
+        Specify whether to normalize the variance of the market with
+        n - 1 instead of n. Defaults to False.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `tuple` of `ndarray`, optional
+        Arrays (beta, alpha) to write the result to instead of allocating
+        new ones. Defaults to None.
+
+    Returns
+    -------
+    beta : `ndarray`
+        An array containing beta values.
+    alpha : `ndarray`
+        An array containing alpha values.
+
+    Examples
+    --------
+    >>> import qufilab as ql
+    >>> import numpy as np
+    ...
+    >>> # Load sample dataframe.
+    >>> df = ql.load_sample('MSFT')
+    >>> df_market = ql.load_sample('DJI')
+    >>> beta, alpha = ql.beta_alpha(df['close'], df_market['close'], periods = 10)
+    """
+    return beta_alpha_calc(data, market, periods, normalize, axis, out)
+
+def universe_beta(data, market, periods, normalize = False, axis = 0, out = None):
+    """
+    .. Universe Beta
+
+    Beta and correlation of the percentage changes of every symbol in a
+    panel against a single market. The market side is only calculated once,
+    which makes this cheaper than calling beta for each symbol.
+
+    Parameters
+    ----------
+    data : `ndarray`
+        A 1D or 2D array containing values, see axis.
+    market : `ndarray`
+        A 1D array containing market values, with one value per bar
+        of data.
+    periods : `int`
+        Number of periods to be used.
+    normalize : `bool`, optional
+        Specify whether to normalize the variance of the market with
+        n - 1 instead of n, the same as for beta. Defaults to False.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `tuple` of `ndarray`, optional
+        Arrays (beta, corr) to write the result to instead of allocating
+        new ones, with the same shape and dtype as data. Defaults to None.
+
+    Returns
+    -------
+    beta : `ndarray`
+        An array containing beta values.
+    corr : `ndarray`
+        An array containing the correlation of the percentage changes.
+
+    Examples
+    --------
+    >>> import qufilab as ql
+    >>> import numpy as np
+    ...
+    >>> # Shape (n_bars, n_symbols).
+    >>> closes = np.random.rand(1000, 500) + 100
+    >>> market = np.random.rand(1000) + 100
+    >>> beta, corr = ql.universe_beta(closes, market, periods = 200)
+    """
+    return universe_beta_calc(data, market, periods, normalize, axis, out)
+
+def cov_matrix(data, periods, normalize = True, final = False, axis = 0, out = None):
+    """
+    .. Covariance Matrix
+
+    Rolling covariance matrix of all pairs of symbols in a panel.
+
+    Parameters
+    ----------
+    data : `ndarray`
+        A 2D array containing values, see axis.
+    periods : `int`
+        Number of periods to be used.
+    normalize : `bool`, optional
+        Specify whether to normalize covariance with 
+        n - 1 instead of n.
+        Defaults to `True`.
+    final : `bool`, optional
+        Only calculate the matrix for the last bar. Defaults to False.
+    axis : `int`, optional
+        Axis along which time runs, 0 for (bars, symbols) and 1 for
+        (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        C-contiguous array to write the result to instead of allocating
+        a new one, with the shape of the result. Defaults to None.
+
+    Returns
+    -------
+    `ndarray`
+        An array with shape (bars, symbols, symbols) containing the
+        covariance matrix of every bar, or (symbols, symbols) if final
+        is True.
+
+    Examples
+    --------
+    >>> import qufilab as ql
+    >>> import numpy as np
+    ...
+    >>> # Shape (n_bars, n_symbols).
+    >>> closes = np.random.rand(1000, 50)
+    >>> cov = ql.cov_matrix(closes, periods = 200)
+    >>> print(cov.shape)
+    (1000, 50, 50)
+    """
+    return cov_matrix_calc(data, periods, normalize, final, axis, out)
+
+def corr_matrix(data, periods, final = False, axis = 0, out = None):
+    """
+    .. Correlation Matrix
+
+    Rolling correlation matrix of all pairs of symbols in a panel.
+
+    Parameters
+    ----------
+    data : `ndarray`
+        A 2D array containing values, see axis.
+    periods : `int`
+        Number of periods to be used.
+    final : `bool`, optional
+        Only calculate the matrix for the last bar. Defaults to False.
+    axis : `int`, optional
+        Axis along which time runs, 0 for (bars, symbols) and 1 for
+        (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        C-contiguous array to write the result to instead of allocating
+        a new one, with the shape of the result. Defaults to None.
+
+    Returns
+    -------
+    `ndarray`
+        An array with shape (bars, symbols, symbols) containing the
+        correlation matrix of every bar, or (symbols, symbols) if final
+        is True.
+
+    Examples
+    --------
+    >>> import qufilab as ql
+    >>> import numpy as np
+    ...
+    >>> # Shape (n_bars, n_symbols).
+    >>> closes = np.random.rand(1000, 50)
+    >>> corr = ql.corr_matrix(closes, periods = 200, final = True)
+    >>> print(corr.shape)
+    (50, 50)
+    """
+    return corr_matrix_calc(data, periods, final, axis, out)
+
+def ewma_cov(data, halflife, final = False, axis = 0, out = None):
+    """
+    .. EWMA Covariance Matrix
+
+    Exponentially weighted covariance matrix of all pairs of symbols in a
+    panel of returns, as in RiskMetrics. The returns are assumed to have
+    zero mean.
+
+    Parameters
+    ----------
+    data : `ndarray`
+        A 2D array containing returns, see axis.
+    halflife : `float`
+        Number of bars after which the weight of a return has halved.
+    final : `bool`, optional
+        Only return the matrix for the last bar, without storing the
+        history. Defaults to False.
+    axis : `int`, optional
+        Axis along which time runs, 0 for (bars, symbols) and 1 for
+        (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        C-contiguous array to write the result to instead of allocating
+        a new one, with the shape of the result. Defaults to None.
+
+    Returns
+    -------
+    `ndarray`
+        An array with shape (bars, symbols, symbols) containing the
+        covariance matrix of every bar, or (symbols, symbols) if final
+        is True.
+
+    Examples
+    --------
+    >>> import qufilab as ql
+    >>> import numpy as np
+    ...
+    >>> # Shape (n_bars, n_symbols).
+    >>> returns = np.random.randn(1000, 2000) * 0.01
+    >>> cov = ql.ewma_cov(returns, halflife = 30, final = True)
+    >>> print(cov.shape)
+    (2000, 2000)
+    """
+    return ewma_cov_calc(data, halflife, final, axis, out)
+
+def ewma_corr(data, halflife, final = False, axis = 0, out = None):
+    """
+    .. EWMA Correlation Matrix
+
+    Exponentially weighted correlation matrix of all pairs of symbols in a
+    panel of returns, see ewma_cov.
+
+    Parameters
+    ----------
+    data : `ndarray`
+        A 2D array containing returns, see axis.
+    halflife : `float`
+        Number of bars after which the weight of a return has halved.
+    final : `bool`, optional
+        Only return the matrix for the last bar, without storing the
+        history. Defaults to False.
+    axis : `int`, optional
+        Axis along which time runs, 0 for (bars, symbols) and 1 for
+        (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        C-contiguous array to write the result to instead of allocating
+        a new one, with the shape of the result. Defaults to None.
+
+    Returns
+    -------
+    `ndarray`
+        An array with shape (bars, symbols, symbols) containing the
+        correlation matrix of every bar, or (symbols, symbols) if final
+        is True.
+
+    Examples
+    --------
+    >>> import qufilab as ql
+    >>> import numpy as np
+    ...
+    >>> # Shape (n_bars, n_symbols).
+    >>> returns = np.random.randn(1000, 2000) * 0.01
+    >>> corr = ql.ewma_corr(returns, halflife = 30, final = True)
+    """
+    return ewma_corr_calc(data, halflife, final, axis, out)
+
+def pct_change(data, periods, axis = 0, out = None):
     """
     .. Percentage Change
 
@@ -163,6 +529,12 @@ def pct_change(data, periods):
         An array containing values.
     periods : `int`
         Number of periods to be used.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -180,4 +552,144 @@ def pct_change(data, periods):
     >>> print(pct_change)
     [nan nan nan ... -1.52155537 -0.81811879 0.25414157]
     """
-    return pct_change_calc(data, periods)
+    return pct_change_calc(data, periods, axis, out)
+
+def rolling_max(data, periods, axis = 0, out = None):
+    """
+    .. Rolling Maximum
+
+    Parameters
+    ----------
+    data : `ndarray`
+        An array containing values.
+    periods : `int`
+        Number of periods to be used.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
+
+    Returns
+    -------
+    `ndarray`
+        An array containing the maximum of the last `periods` values. Windows
+        containing NaN give NaN.
+
+    Examples
+    --------
+    >>> import qufilab as ql
+    >>> import numpy as np
+    ...
+    >>> # Load sample dataframe.
+    >>> df = ql.load_sample('MSFT')
+    >>> highest = ql.rolling_max(df['high'], periods = 20)
+    """
+    return rolling_max_calc(data, periods, axis, out)
+
+def rolling_min(data, periods, axis = 0, out = None):
+    """
+    .. Rolling Minimum
+
+    Parameters
+    ----------
+    data : `ndarray`
+        An array containing values.
+    periods : `int`
+        Number of periods to be used.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
+
+    Returns
+    -------
+    `ndarray`
+        An array containing the minimum of the last `periods` values. Windows
+        containing NaN give NaN.
+
+    Examples
+    --------
+    >>> import qufilab as ql
+    >>> import numpy as np
+    ...
+    >>> # Load sample dataframe.
+    >>> df = ql.load_sample('MSFT')
+    >>> lowest = ql.rolling_min(df['low'], periods = 20)
+    """
+    return rolling_min_calc(data, periods, axis, out)
+
+def rolling_argmax(data, periods, axis = 0, out = None):
+    """
+    .. Rolling Position of the Maximum
+
+    Parameters
+    ----------
+    data : `ndarray`
+        An array containing values.
+    periods : `int`
+        Number of periods to be used.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
+
+    Returns
+    -------
+    `ndarray`
+        An array containing the position of the maximum in the last `periods`
+        values, from 0 for the oldest value to `periods` - 1 for the latest.
+        The earliest position is used if the maximum occurs more than once.
+        Windows containing NaN give NaN.
+
+    Examples
+    --------
+    >>> import qufilab as ql
+    >>> import numpy as np
+    ...
+    >>> # Load sample dataframe.
+    >>> df = ql.load_sample('MSFT')
+    >>> argmax = ql.rolling_argmax(df['high'], periods = 20)
+    """
+    return rolling_argmax_calc(data, periods, axis, out)
+
+def rolling_argmin(data, periods, axis = 0, out = None):
+    """
+    .. Rolling Position of the Minimum
+
+    Parameters
+    ----------
+    data : `ndarray`
+        An array containing values.
+    periods : `int`
+        Number of periods to be used.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
+
+    Returns
+    -------
+    `ndarray`
+        An array containing the position of the minimum in the last `periods`
+        values, from 0 for the oldest value to `periods` - 1 for the latest.
+        The earliest position is used if the minimum occurs more than once.
+        Windows containing NaN give NaN.
+
+    Examples
+    --------
+    >>> import qufilab as ql
+    >>> import numpy as np
+    ...
+    >>> # Load sample dataframe.
+    >>> df = ql.load_sample('MSFT')
+    >>> argmin = ql.rolling_argmin(df['low'], periods = 20)
+    """
+    return rolling_argmin_calc(data, periods, axis, out)
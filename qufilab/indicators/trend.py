@@ -11,7 +11,7 @@ import numpy as np
 from qufilab.indicators._trend import *
 
 
-def sma(data, periods):
+def sma(data, periods, axis = 0, out = None):
     """
     .. Simple moving average
 
@@ -21,6 +21,12 @@ def sma(data, periods):
         An array containing values.
     periods : `int`
         Number of periods to be used.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -49,9 +55,9 @@ def sma(data, periods):
         \\frac{1}{n}\sum_{i=0}^{n-1} price_{K-i}
 
     """
-    return sma_calc(data, periods)
+    return sma_calc(data, periods, axis, out)
 
-def ema(data, periods):
+def ema(data, periods, axis = 0, out = None):
     """
     .. Exponential Moving Average
 
@@ -61,6 +67,12 @@ def ema(data, periods):
         An array containing values.
     periods : `int`
         Number of periods to be used.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -96,10 +108,10 @@ def ema(data, periods):
     the period *n*. Observe that for the first ema value, a simple moving average
     is used.
     """
-    return ema_calc(data, periods)
+    return ema_calc(data, periods, axis, out)
 
 
-def dema(data, periods):
+def dema(data, periods, axis = 0, out = None):
     """
     .. Double Exponential Moving Average
 
@@ -109,6 +121,12 @@ def dema(data, periods):
         An array containing values.
     periods : `int`
         Number of periods to be used.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -134,9 +152,9 @@ def dema(data, periods):
         dema_K = 2 \cdot ema_K - ema(ema_K)
 
     """
-    return dema_calc(data, periods)
+    return dema_calc(data, periods, axis, out)
 
-def tema(data, periods):
+def tema(data, periods, axis = 0, out = None):
     """
     .. Triple Exponential Moving Average
 
@@ -146,6 +164,12 @@ def tema(data, periods):
         An array containing values.
     periods : `int`
         Number of periods to be used.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -173,9 +197,9 @@ def tema(data, periods):
     .. math::
         tema_K = 3 \cdot ema_K - 3 \cdot ema(ema_K) + ema(ema(ema_K))
     """
-    return tema_calc(data, periods)
+    return tema_calc(data, periods, axis, out)
 
-def t3(data, periods, volume_factor = 0.7):
+def t3(data, periods, volume_factor = 0.7, axis = 0, out = None):
     """
     .. T3 Moving Average
 
@@ -188,6 +212,12 @@ def t3(data, periods, volume_factor = 0.7):
     volume_factor : `float`, optional
         What volume factor to be used when calculating the constants. 
         See `Notes` below for implementation.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -240,10 +270,10 @@ def t3(data, periods, volume_factor = 0.7):
     if volume_factor < 0:
         raise ValueError("Param 'volume_factor' needs to be bigger than zero")
 
-    return t3_calc(data, periods, volume_factor)
+    return t3_calc(data, periods, volume_factor, axis, out)
 
 
-def tma(data, periods):
+def tma(data, periods, axis = 0, out = None):
     """
     .. Triangular Moving Average
 
@@ -253,6 +283,12 @@ def tma(data, periods):
         An array containing values.
     periods : `int`
         Number of periods to be used.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -292,9 +328,9 @@ def tma(data, periods):
     .. math::
         n_1 = n_2 = \\frac{periods + 1}{2}
     """
-    return tma_calc(data, periods)
+    return tma_calc(data, periods, axis, out)
 
-def smma(data, periods):
+def smma(data, periods, axis = 0, out = None):
     """
     .. Smoothed Moving Average
 
@@ -304,6 +340,12 @@ def smma(data, periods):
         An array containing values.
     periods : `int`
         Number of periods to be used.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -323,9 +365,9 @@ def smma(data, periods):
     >>> print(smma)
     [nan nan nan ... 208.85810754 209.43029679 209.78926711]
     """
-    return smma_calc(data, periods)
+    return smma_calc(data, periods, axis, out)
 
-def lwma(data, periods):
+def lwma(data, periods, axis = 0, out = None):
     """
     .. Linear Weighted Moving Average
 
@@ -335,6 +377,12 @@ def lwma(data, periods):
         An array containing values.
     periods : `int`
         Number of periods to be used.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -367,9 +415,9 @@ def lwma(data, periods):
 
     where :math:`w_1 = 1, w_2 = 2,... w_n = n`
     """
-    return lwma_calc(data, periods)
+    return lwma_calc(data, periods, axis, out)
 
-def wc(high, low, close):
+def wc(high, low, close, axis = 0, out = None):
     """
     .. Weighted Close
 
@@ -381,6 +429,12 @@ def wc(high, low, close):
         An array containing low prices.
     close : `ndarray`
         An array containing closing prices.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -405,7 +459,111 @@ def wc(high, low, close):
     .. math:: wc_K = \\frac{2 \cdot close_K + high_K + low_K}{4}
 
     """
-    return wc_calc(close, high, low)
+    return wc_calc(close, high, low, axis, out)
 
+def sma_multi(data, periods, out = None):
+    """
+    .. Simple Moving Average for multiple periods
+
+    Parameters
+    ----------
+    data : `ndarray`
+        An array containing values.
+    periods : `list` of `int`
+        Periods to be used, one simple moving average is calculated per period.
+    out : `ndarray`, optional
+        C-contiguous array with shape ``(len(periods), len(data))`` to write
+        the result to instead of allocating a new one. Defaults to None.
+
+    Returns
+    -------
+    `ndarray`
+        A 2D array with shape ``(len(periods), len(data))``, where row *i*
+        contains the simple moving average for ``periods[i]``.
 
+    Examples
+    --------
+    >>> import qufilab as ql
+    >>> import numpy as np
+    ... 
+    >>> # Load a sample dataframe.
+    >>> df = ql.load_sample('MSFT')
+    >>> sma = ql.sma_multi(df['close'], periods = [10, 20, 50])
+    >>> print(sma.shape)
+    (3, 100)
+
+    Notes
+    -----
+    The data is only read once to build prefix sums with compensated summation, and
+    every period is then calculated from differences of these sums. This is 
+    considerably faster than calling :func:`sma` once per period, for example 
+    in parameter sweeps.
+    """
+    periods = list(periods)
+    if any(period < 1 for period in periods):
+        raise ValueError("Param 'periods' can only contain positive integers")
+
+    return sma_multi_calc(data, periods, out)
+
+def ema_multi(data, periods, out = None):
+    """
+    .. Exponential Moving Average for multiple periods
+
+    Parameters
+    ----------
+    data : `ndarray`
+        An array containing values.
+    periods : `list` of `int`
+        Periods to be used, one exponential moving average is calculated per period.
+    out : `ndarray`, optional
+        C-contiguous array with shape ``(len(periods), len(data))`` to write
+        the result to instead of allocating a new one. Defaults to None.
+
+    Returns
+    -------
+    `ndarray`
+        A 2D array with shape ``(len(periods), len(data))``, where row *i*
+        contains the exponential moving average for ``periods[i]``.
+
+    Notes
+    -----
+    The starting simple moving average of each period is taken from one shared
+    set of prefix sums, and the periods are calculated in parallel.
+    See :func:`ema` for the calculation.
+    """
+    periods = list(periods)
+    if any(period < 1 for period in periods):
+        raise ValueError("Param 'periods' can only contain positive integers")
+
+    return ema_multi_calc(data, periods, out)
+
+def lwma_multi(data, periods, out = None):
+    """
+    .. Linear Weighted Moving Average for multiple periods
+
+    Parameters
+    ----------
+    data : `ndarray`
+        An array containing values.
+    periods : `list` of `int`
+        Periods to be used, one linear weighted moving average is calculated per period.
+    out : `ndarray`, optional
+        C-contiguous array with shape ``(len(periods), len(data))`` to write
+        the result to instead of allocating a new one. Defaults to None.
+
+    Returns
+    -------
+    `ndarray`
+        A 2D array with shape ``(len(periods), len(data))``, where row *i*
+        contains the linear weighted moving average for ``periods[i]``.
+
+    Notes
+    -----
+    Uses one plain and one linearly weighted set of prefix sums, shared by all periods.
+    See :func:`lwma` for the calculation.
+    """
+    periods = list(periods)
+    if any(period < 1 for period in periods):
+        raise ValueError("Param 'periods' can only contain positive integers")
 
+    return lwma_multi_calc(data, periods, out)
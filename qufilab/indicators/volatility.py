@@ -9,7 +9,7 @@ import numpy as np
 
 from qufilab.indicators._volatility import *
 
-def bbands(price, period, deviation = 2):
+def bbands(price, period, deviation = 2, outputs = None, axis = 0, out = None):
     """
     .. Bollinger Bands
 
@@ -22,6 +22,19 @@ def bbands(price, period, deviation = 2):
     deviation : `int`, optional
         Number of standard deviations from the mean.
         Defaults to 20.
+    outputs : `list` of `str`, optional
+        Names of the outputs to calculate, in the order they are returned,
+        from 'upper', 'middle', 'lower', 'percent_b' and 'bandwidth'. All
+        outputs are calculated in a single pass, and outputs that aren't
+        requested are neither allocated nor calculated.
+        Defaults to None, i.e. upper, middle and lower.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `tuple` of `ndarray`, optional
+        Arrays to write the results to instead of allocating new ones, one
+        per returned array, with the same shape and dtype as the input.
+        Defaults to None.
 
     Returns
     -------
@@ -31,10 +44,22 @@ def bbands(price, period, deviation = 2):
         middle bollinger band.
     lower : `ndarray`
         lower bollinger band.
+
+    If outputs is given, a tuple with the requested outputs is returned
+    instead, or a single array if only one output is requested. Here
+    percent_b is (price - lower) / (upper - lower) and bandwidth is
+    (upper - lower) / middle.
     """
-    return bbands_calc(price, period, deviation)
+    if outputs is None:
+        return bbands_calc(price, period, deviation, axis, out)
+
+    if isinstance(outputs, str):
+        outputs = [outputs]
+
+    result = bbands_outputs_calc(price, period, deviation, list(outputs), axis, out)
+    return result[0] if len(result) == 1 else tuple(result)
 
-def kc(close, high, low, period = 20, period_atr = 20, deviation = 2):
+def kc(close, high, low, period = 20, period_atr = 20, deviation = 2, axis = 0, out = None):
     """
     .. Keltner channels
 
@@ -55,6 +80,13 @@ def kc(close, high, low, period = 20, period_atr = 20, deviation = 2):
     deviation : `int`, optional
         Number of deviations from the mean.
         Defaults to 2.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `tuple` of `ndarray`, optional
+        Arrays to write the results to instead of allocating new ones, one
+        per returned array, with the same shape and dtype as the input.
+        Defaults to None.
 
     Returns
     -------
@@ -65,9 +97,9 @@ def kc(close, high, low, period = 20, period_atr = 20, deviation = 2):
     lower : `ndarray`
         lower keltner band.
     """
-    return kc_calc(close, high, low, period, period_atr, deviation)
+    return kc_calc(close, high, low, period, period_atr, deviation, axis, out)
 
-def atr(close, high, low, period):
+def atr(close, high, low, period, axis = 0, out = None):
     """
     .. Average true range
 
@@ -81,6 +113,12 @@ def atr(close, high, low, period):
         Array of type float64 or float32 containing the low prices.
     period : `int`
         Number of periods to be used.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -88,9 +126,42 @@ def atr(close, high, low, period):
         Array of type float64 or float32 containing the calculated
         average true range values.
     """
-    return atr_calc(close, high, low, period)
+    return atr_calc(close, high, low, period, axis, out)
+
+def trange(close, high, low, axis = 0, out = None):
+    """
+    .. True range
+
+    Parameters
+    ----------
+    close : `ndarray`
+        Array of type float64 or float32 containing the closing prices.
+    high : `ndarray`
+        Array of type float64 or float32 containing the high prices.
+    low : `ndarray`
+        Array of type float64 or float32 containing the low prices.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
+
+    Returns
+    -------
+    `ndarray`
+        Array of type float64 or float32 containing the true range values.
+        The first value is NaN since it has no previous close.
+
+    Notes
+    -----
+    The true range is calculated with SSE2, AVX2 or AVX-512 depending on
+    what the CPU supports. The environment variable QUFILAB_SIMD can be set
+    to 'scalar', 'sse2' or 'avx2' before import to use a lower level.
+    """
+    return trange_calc(close, high, low, axis, out)
 
-def cv(high, low, period = 10, smoothing_period = 10):
+def cv(high, low, period = 10, smoothing_period = 10, axis = 0, out = None):
     """
     .. Chaikin volatility
 
@@ -106,6 +177,12 @@ def cv(high, low, period = 10, smoothing_period = 10):
     smooting_period : `int`, optional
         Number of periods to be used for smoothing chaikin volatility values.
         Defaults to 10.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -113,4 +190,4 @@ def cv(high, low, period = 10, smoothing_period = 10):
         Array of type float64 or float32 containing the calculated
         chaikin volatility values.
     """
-    return cv_calc(high, low, period, smoothing_period)
+    return cv_calc(high, low, period, smoothing_period, axis, out)
@@ -10,7 +10,7 @@ import numpy as np
 
 from qufilab.indicators._volume import *
 
-def acdi(close, high, low, volume):
+def acdi(close, high, low, volume, axis = 0, out = None):
     """
     .. Accumulation distribution
 
@@ -24,6 +24,12 @@ def acdi(close, high, low, volume):
         Array of type float64 or float32 containing low prices.
     volume : `ndarray`
         Array of type float64 or float32 containing volume values.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -31,9 +37,9 @@ def acdi(close, high, low, volume):
         Array of type float64 or float32 containing the calculated
         accumulation distribution values.
     """
-    return acdi_calc(close, high, low, volume)
+    return acdi_calc(close, high, low, volume, axis, out)
 
-def obv(price, volume):
+def obv(price, volume, axis = 0, out = None):
     """
     .. On balance volume
 
@@ -43,6 +49,12 @@ def obv(price, volume):
         Array of type float64 or float32 containing prices.
     volume : `ndarray`
         Array of type float64 or float32 containing volume values.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -51,9 +63,9 @@ def obv(price, volume):
         on balance volume values.
     """
 
-    return obv_calc(price, volume)
+    return obv_calc(price, volume, axis, out)
 
-def cmf(close, high, low, volume, period = 21):
+def cmf(close, high, low, volume, period = 21, axis = 0, out = None):
     """
     .. Chaikin money flow
 
@@ -70,16 +82,27 @@ def cmf(close, high, low, volume, period = 21):
     period : `int`, optional
         Number of periods to use.
         Defaults to 21.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
     `ndarray`
         Array of type float64 or float32 containing the calculated
         chaikin money flow values.
+
+    Notes
+    -----
+    Bars where the high isn't above the low add no money flow, the same as
+    in acdi.
     """
-    return cmf_calc(close, high, low, volume, period)
+    return cmf_calc(close, high, low, volume, period, axis, out)
 
-def ci(close, high, low, volume):
+def ci(close, high, low, volume, axis = 0, out = None):
     """
     .. Chaikin indicator
 
@@ -93,6 +116,12 @@ def ci(close, high, low, volume):
         Array of type float64 or float32 containing low prices.
     volume : `ndarray`
         Array of type float64 or float32 containing volume values.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -100,9 +129,9 @@ def ci(close, high, low, volume):
         Array of type float64 or float32 containing the calculated
         chaikin indicator values.
     """
-    return ci_calc(close, high, low, volume)
+    return ci_calc(close, high, low, volume, axis, out)
 
-def pvi(price, volume):
+def pvi(price, volume, axis = 0, out = None):
     """
     .. Positive volume index
 
@@ -112,6 +141,12 @@ def pvi(price, volume):
         Array of type float64 or float32 containing prices.
     volume : `ndarray`
         Array of type float64 or float32 containing volume values.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -119,9 +154,9 @@ def pvi(price, volume):
         Array of type float64 or float32 containing the calculated
         positive volume index values.
     """
-    return pvi_calc(price, volume)
+    return pvi_calc(price, volume, axis, out)
 
-def nvi(price, volume):
+def nvi(price, volume, axis = 0, out = None):
     """
     .. Negative volume index
 
@@ -131,6 +166,12 @@ def nvi(price, volume):
         Array of type float64 or float32 containing prices.
     volume : `ndarray`
         Array of type float64 or float32 containing volume values.
+    axis : `int`, optional
+        Axis along which time runs if 2D arrays are given, 0 for
+        (bars, symbols) and 1 for (symbols, bars). Defaults to 0.
+    out : `ndarray`, optional
+        Array to write the result to instead of allocating a new one, with
+        the same shape and dtype as the input. Defaults to None.
 
     Returns
     -------
@@ -138,4 +179,4 @@ def nvi(price, volume):
         Array of type float64 or float32 containing the calculated
         negative volume index values.
     """
-    return nvi_calc(price, volume)
+    return nvi_calc(price, volume, axis, out)
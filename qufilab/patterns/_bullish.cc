@@ -5,29 +5,21 @@
  *
  */
 
-#include <iostream>
 #include <string>
-#include <cmath>
-#include <limits>
-#include <numeric>
-#include <cstdint>
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 
 #include "_bullish.h"
 
-#include "candlestick.h"
 #include "data_container.h"
 #include "pattern_utility.h"
-#include "conditions.h"
 
-#include "../indicators/util.h"
-#include "../indicators/_trend.h"
+#include "../core/patterns.h"
 
 namespace py = pybind11;
 
 /*
- *  Implementation of HAMMER.
+ *  HAMMER of the price arrays, see hammer_kernel in core/patterns.h.
  *
  *  Params:
  *      high (py::array_t<T>) : Array with high prices.
@@ -39,36 +31,43 @@ namespace py = pybind11;
  *          should be calculated.
  *      shadow_marign (T) : How much margin should be allowed on the 
  *          upper shadow.
+ *      out (py::object) : Array to write the result to, or None.
  */
-template <typename T>
-py::array_t<bool> hammer_calc(const py::array_t<T> high, 
+template <typename T, HammerType type>
+py::array_t<bool> hammer_pattern(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
         const py::array_t<T> close, const int trend_period, 
-        const std::string type, const T shadow_margin) {
-    
-    const int body_avg_period = 14;
+        const T shadow_margin, const py::object out) {
 
     InputContainer<T> data = {high, low, open, close};
-    ResultContainer result_container = {data.size};
-    auto trend = get_trend("sma", close, trend_period);
-    auto body_avg = get_body_avg(open, close, body_avg_period);
-
-    for (int idx = body_avg_period; idx < data.size; ++idx) {
-        Candlestick<T> candle = {data.high[idx], data.low[idx], 
-            data.open[idx], data.close[idx], body_avg[idx], trend[idx]};
-
-        bool conditions = hammer_conditions(candle, shadow_margin, type);
-        if (conditions == true) {
-            result_container.found_pattern(idx);
-        }
+    ResultContainer result_container = {data.size, out};
+
+    {
+        py::gil_scoped_release release;
+        hammer_kernel<T, type>(data.high, data.low, data.open, data.close,
+                result_container.result_ptr, data.size, trend_period, shadow_margin);
     }
 
     return result_container.result;
 }
 
+template <typename T>
+py::array_t<bool> hammer_calc(const py::array_t<T> high, 
+        const py::array_t<T> low, const py::array_t<T> open, 
+        const py::array_t<T> close, const int trend_period, 
+        const std::string type, const T shadow_margin, const py::object out) {
+    if (hammer_type(type) == HammerType::hammer) {
+        return hammer_pattern<T, HammerType::hammer>(high, low, open,
+            close, trend_period, shadow_margin, out);
+    }
+
+    return hammer_pattern<T, HammerType::inverted_hammer>(high, low, open,
+            close, trend_period, shadow_margin, out);
+}
+
 
 /*
- *  Implementation of DOJI.
+ *  DOJI of the price arrays, see doji_kernel in core/patterns.h.
  *  
  *  Params:
  *      high (py::array_t<T>) : Array with high prices.
@@ -76,36 +75,28 @@ py::array_t<bool> hammer_calc(const py::array_t<T> high,
  *      open (py::array_t<T>) : Array with opening prices.
  *      close (py::array_t<T>) : Array with close prices.
  *      trend_period (int) : Specify the period for identify trend.
+ *      out (py::object) : Array to write the result to, or None.
  */
 template <typename T>
 py::array_t<bool> doji_calc(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
-        const py::array_t<T> close, const int trend_period) {
-
-    const int body_avg_period = 14;
+        const py::array_t<T> close, const int trend_period, const py::object out) {
 
     InputContainer<T> data = {high, low, open, close};
-    ResultContainer result_container = {data.size};
-    auto trend = get_trend("sma", close, trend_period);
-    auto body_avg = get_body_avg(open, close, body_avg_period);
+    ResultContainer result_container = {data.size, out};
 
-    for (int idx = body_avg_period ; idx < data.size; ++idx) {
-        Candlestick<T> candle = {data.high[idx], data.low[idx], 
-            data.open[idx], data.close[idx], body_avg[idx], trend[idx]};
-
-        bool correct_cond = doji_conditions(candle);
-        if (correct_cond) {
-            result_container.found_pattern(idx);
-        }
-
-    }    
+    {
+        py::gil_scoped_release release;
+        doji_kernel<T>(data.high, data.low, data.open, data.close,
+                result_container.result_ptr, data.size, trend_period);
+    }
 
     return result_container.result;
 }
 
 
 /*
- *  Implementation of DRAGONFLY_DOJI.
+ *  DRAGONFLY_DOJI of the price arrays, see dragonfly_doji_kernel in core/patterns.h.
  *  
  *  Params:
  *      high (py::array_t<T>) : Array with high prices.
@@ -113,34 +104,27 @@ py::array_t<bool> doji_calc(const py::array_t<T> high,
  *      open (py::array_t<T>) : Array with opening prices.
  *      close (py::array_t<T>) : Array with close prices.
  *      trend_period (int) : Specify the period for identify trend.
+ *      out (py::object) : Array to write the result to, or None.
  */
 template <typename T>
 py::array_t<bool> dragonfly_doji_calc(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
-        const py::array_t<T> close, const int trend_period) {
-    
-    const int body_avg_period = 14;
+        const py::array_t<T> close, const int trend_period, const py::object out) {
 
     InputContainer<T> data = {high, low, open, close};
-    ResultContainer result_container = {data.size};
-    auto trend = get_trend("sma", close, trend_period);
-    auto body_avg = get_body_avg(open, close, body_avg_period);
-
-    for (int idx = body_avg_period; idx < data.size; ++idx) {
-        Candlestick<T> candle = {data.high[idx], data.low[idx], 
-            data.open[idx], data.close[idx], body_avg[idx], trend[idx]};
-        
-        bool correct_cond = dragonfly_doji_conditions(candle);
-        if (correct_cond) {
-            result_container.found_pattern(idx);
-        }
-    }    
+    ResultContainer result_container = {data.size, out};
+
+    {
+        py::gil_scoped_release release;
+        dragonfly_doji_kernel<T>(data.high, data.low, data.open, data.close,
+                result_container.result_ptr, data.size, trend_period);
+    }
 
     return result_container.result;
 }
 
 /*
- *  Implementation of MARUBOZU_WHITE.
+ *  MARUBOZU_WHITE of the price arrays, see marubozu_white_kernel in core/patterns.h.
  *  
  *  Params:
  *      high (py::array_t<T>) : Array with high prices.
@@ -151,34 +135,28 @@ py::array_t<bool> dragonfly_doji_calc(const py::array_t<T> high,
  *          for the shadows. For example, by using shadow_marign = 5, one allows
  *          the upper/lower shadows to be as high as 5% of the body size.
  *      trend_period (int) : Specify the period for identify trend.
+ *      out (py::object) : Array to write the result to, or None.
  */
 template <typename T>
 py::array_t<bool> marubozu_white_calc(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
-        py::array_t<T> close, T shadow_margin, const int trend_period) {
-
-    const int body_avg_period = 14;
+        py::array_t<T> close, T shadow_margin, const int trend_period,
+        const py::object out) {
 
     InputContainer<T> data = {high, low, open, close};
-    ResultContainer result_container = {data.size};
-    auto trend = get_trend("sma", close, trend_period);
-    auto body_avg = get_body_avg(open, close, body_avg_period);
-
-    for (int idx = body_avg_period; idx < data.size; ++idx) {
-        Candlestick<T> candle = {data.high[idx], data.low[idx], 
-            data.open[idx], data.close[idx], body_avg[idx], trend[idx]};
-        
-        bool correct_cond = marubozu_white_conditions(candle, shadow_margin);
-        if (correct_cond) {
-            result_container.found_pattern(idx);
-        }
-    }    
+    ResultContainer result_container = {data.size, out};
+
+    {
+        py::gil_scoped_release release;
+        marubozu_white_kernel<T>(data.high, data.low, data.open, data.close,
+                result_container.result_ptr, data.size, trend_period, shadow_margin);
+    }
 
     return result_container.result;
 }
 
 /*
- *  Implementation of MARUBOZU_BLACK.
+ *  MARUBOZU_BLACK of the price arrays, see marubozu_black_kernel in core/patterns.h.
  *  
  *  Params:
  *      high (py::array_t<T>) : Array with high prices.
@@ -189,34 +167,28 @@ py::array_t<bool> marubozu_white_calc(const py::array_t<T> high,
  *          for the shadows. For example, by using shadow_marign = 5, one allows
  *          the upper/lower shadows to be as high as 5% of the body size.
  *      trend_period (int) : Specify the period for identify trend.
+ *      out (py::object) : Array to write the result to, or None.
  */
 template <typename T>
 py::array_t<bool> marubozu_black_calc(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
-        py::array_t<T> close, T shadow_margin, const int trend_period) {
-
-    const int body_avg_period = 14;
+        py::array_t<T> close, T shadow_margin, const int trend_period,
+        const py::object out) {
 
     InputContainer<T> data = {high, low, open, close};
-    ResultContainer result_container = {data.size};
-    auto trend = get_trend("sma", close, trend_period);
-    auto body_avg = get_body_avg(open, close, body_avg_period);
-
-    for (int idx = body_avg_period; idx < data.size; ++idx) {
-        Candlestick<T> candle = {data.high[idx], data.low[idx], 
-            data.open[idx], data.close[idx], body_avg[idx], trend[idx]};
-        
-        bool correct_cond = marubozu_black_conditions(candle, shadow_margin);
-        if (correct_cond) {
-            result_container.found_pattern(idx);
-        }
-    }    
+    ResultContainer result_container = {data.size, out};
+
+    {
+        py::gil_scoped_release release;
+        marubozu_black_kernel<T>(data.high, data.low, data.open, data.close,
+                result_container.result_ptr, data.size, trend_period, shadow_margin);
+    }
 
     return result_container.result;
 }
 
 /*
- *  Implementation of SPINNING_TOP_WHITE.
+ *  SPINNING_TOP_WHITE of the price arrays, see spinning_top_white_kernel in core/patterns.h.
  *  
  *  Params:
  *      high (py::array_t<T>) : Array with high prices.
@@ -224,34 +196,27 @@ py::array_t<bool> marubozu_black_calc(const py::array_t<T> high,
  *      open (py::array_t<T>) : Array with opening prices.
  *      close (py::array_t<T>) : Array with close prices.
  *      trend_period (int) : Specify the period for identify trend.
+ *      out (py::object) : Array to write the result to, or None.
  */
 template <typename T>
 py::array_t<bool> spinning_top_white_calc(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
-        py::array_t<T> close, const int trend_period) {
-    
-    const int body_avg_period = 14;
+        py::array_t<T> close, const int trend_period, const py::object out) {
 
     InputContainer<T> data = {high, low, open, close};
-    ResultContainer result_container = {data.size};
-    auto trend = get_trend("sma", close, trend_period);
-    auto body_avg = get_body_avg(open, close, body_avg_period);
+    ResultContainer result_container = {data.size, out};
 
-    for (int idx = body_avg_period; idx < data.size; ++idx) {
-        Candlestick<T> candle = {data.high[idx], data.low[idx], 
-            data.open[idx], data.close[idx], body_avg[idx], trend[idx]};
-
-        bool correct_cond = spinning_top_white_conditions(candle);
-        if (correct_cond) {
-            result_container.found_pattern(idx);
-        }
-    }    
+    {
+        py::gil_scoped_release release;
+        spinning_top_white_kernel<T>(data.high, data.low, data.open, data.close,
+                result_container.result_ptr, data.size, trend_period);
+    }
 
     return result_container.result;
 }
 
 /*
- *  Implementation of ENGULFING.
+ *  ENGULFING of the price arrays, see engulfing_kernel in core/patterns.h.
  *  
  *  Params:
  *      high (py::array_t<T>) : Array with high prices.
@@ -261,39 +226,42 @@ py::array_t<bool> spinning_top_white_calc(const py::array_t<T> high,
  *      trend_period (int) : Period for moving average in order to identify trend.
  *      type (string) : Specify what kind of engulfing type that should
  *          be calculated. Can choose from 'bull' or 'bear'.
+ *      out (py::object) : Array to write the result to, or None.
  */
-template <typename T>
-py::array_t<bool> engulfing_calc(const py::array_t<T> high, 
+template <typename T, Direction type>
+py::array_t<bool> engulfing_pattern(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
         py::array_t<T> close, const int trend_period, 
-        const std::string type) {
-    
-    const int body_avg_period = 14;
+        const py::object out) {
 
     InputContainer<T> data = {high, low, open, close};
-    ResultContainer result_container = {data.size};
-    auto trend = get_trend("sma", close, trend_period);
-    auto body_avg = get_body_avg(open, close, body_avg_period);
-
-    for (int idx = body_avg_period + 1; idx < data.size; ++idx) {
-        Candlestick<T> candle_prev = {data.high[idx-1], data.low[idx-1], 
-            data.open[idx-1], data.close[idx-1], body_avg[idx-1], trend[idx-1]};
-
-        Candlestick<T> candle = {data.high[idx], data.low[idx], 
-            data.open[idx], data.close[idx], body_avg[idx], trend[idx]};
-        
-        bool correct_cond = engulfing_conditions(candle, candle_prev, type);
-        if (correct_cond) {
-            result_container.found_pattern(idx);
-        }
+    ResultContainer result_container = {data.size, out};
 
+    {
+        py::gil_scoped_release release;
+        engulfing_kernel<T, type>(data.high, data.low, data.open, data.close,
+                result_container.result_ptr, data.size, trend_period);
     }
 
     return result_container.result;
 }
 
+template <typename T>
+py::array_t<bool> engulfing_calc(const py::array_t<T> high, 
+        const py::array_t<T> low, const py::array_t<T> open, 
+        py::array_t<T> close, const int trend_period, 
+        const std::string type, const py::object out) {
+    if (pattern_direction(type) == Direction::bull) {
+        return engulfing_pattern<T, Direction::bull>(high, low, open,
+            close, trend_period, out);
+    }
+
+    return engulfing_pattern<T, Direction::bear>(high, low, open,
+            close, trend_period, out);
+}
+
 /*
- *  Implementation of HARAMI.
+ *  HARAMI of the price arrays, see harami_kernel in core/patterns.h.
  *  
  *  Params:
  *      high (py::array_t<T>) : Array with high prices.
@@ -303,39 +271,42 @@ py::array_t<bool> engulfing_calc(const py::array_t<T> high,
  *      trend_period (int) : Period for moving average in order to identify trend.
  *      type (string) : Specify what kind of harami type that should
  *          be calculated. Can choose from 'bull' or 'bear'.
+ *      out (py::object) : Array to write the result to, or None.
  */
-template <typename T>
-py::array_t<bool> harami_calc(const py::array_t<T> high, 
+template <typename T, Direction type>
+py::array_t<bool> harami_pattern(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
         py::array_t<T> close, const int trend_period, 
-        const std::string type) {
-    
-    const int body_avg_period = 14;
+        const py::object out) {
 
     InputContainer<T> data = {high, low, open, close};
-    ResultContainer result_container = {data.size};
-    auto trend = get_trend("sma", close, trend_period);
-    auto body_avg = get_body_avg(open, close, body_avg_period);
-    
-    for (int idx = body_avg_period + 1; idx < data.size; ++idx) {
-        Candlestick<T> candle_prev = {data.high[idx-1], data.low[idx-1], 
-            data.open[idx-1], data.close[idx-1], body_avg[idx-1], trend[idx-1]};
-
-        Candlestick<T> candle = {data.high[idx], data.low[idx], 
-            data.open[idx], data.close[idx], body_avg[idx], trend[idx]};
-    
-        bool correct_cond = harami_conditions(candle, candle_prev, type);
-        if (correct_cond) {
-            result_container.found_pattern(idx);
-        }
+    ResultContainer result_container = {data.size, out};
 
+    {
+        py::gil_scoped_release release;
+        harami_kernel<T, type>(data.high, data.low, data.open, data.close,
+                result_container.result_ptr, data.size, trend_period);
     }
 
     return result_container.result;
 }
 
+template <typename T>
+py::array_t<bool> harami_calc(const py::array_t<T> high, 
+        const py::array_t<T> low, const py::array_t<T> open, 
+        py::array_t<T> close, const int trend_period, 
+        const std::string type, const py::object out) {
+    if (pattern_direction(type) == Direction::bull) {
+        return harami_pattern<T, Direction::bull>(high, low, open,
+            close, trend_period, out);
+    }
+
+    return harami_pattern<T, Direction::bear>(high, low, open,
+            close, trend_period, out);
+}
+
 /*
- *  Implementation of KICKING.
+ *  KICKING of the price arrays, see kicking_kernel in core/patterns.h.
  *   
  *  Params:
  *      high (py::array_t<T>) : Array with high prices.
@@ -348,39 +319,41 @@ py::array_t<bool> harami_calc(const py::array_t<T> high,
  *      shadow_margin (float) : Float specifying what margin should be allowed
  *          for the shadows. For example, by using shadow_marign = 5, one allows
  *          the upper/lower shadows to be as long as 5% of the body size.
+ *      out (py::object) : Array to write the result to, or None.
  */
-template <typename T>
-py::array_t<bool> kicking_calc(const py::array_t<T> high, 
+template <typename T, Direction type>
+py::array_t<bool> kicking_pattern(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
-        py::array_t<T> close, const int trend_period, const std::string type,
-        const float shadow_margin) {
-
-    const int body_avg_period = 14;
+        py::array_t<T> close, const int trend_period, const float shadow_margin, const py::object out) {
 
     InputContainer<T> data = {high, low, open, close};
-    ResultContainer result_container = {data.size};
-    auto trend = get_trend("sma", close, trend_period);
-    auto body_avg = get_body_avg(open, close, body_avg_period);
-
-    for (int idx = body_avg_period + 1; idx < data.size; ++idx) {
-        Candlestick<T> candle_prev = {data.high[idx-1], data.low[idx-1], 
-            data.open[idx-1], data.close[idx-1], body_avg[idx-1], trend[idx-1]};
-
-        Candlestick<T> candle = {data.high[idx], data.low[idx], 
-            data.open[idx], data.close[idx], body_avg[idx], trend[idx]};
-        
-        bool correct_cond = kicking_conditions(candle, candle_prev, shadow_margin,
-                type);
-        if (correct_cond) {
-            result_container.found_pattern(idx);
-        }
+    ResultContainer result_container = {data.size, out};
+
+    {
+        py::gil_scoped_release release;
+        kicking_kernel<T, type>(data.high, data.low, data.open, data.close,
+                result_container.result_ptr, data.size, trend_period, shadow_margin);
     }
 
     return result_container.result;
 }
 
+template <typename T>
+py::array_t<bool> kicking_calc(const py::array_t<T> high, 
+        const py::array_t<T> low, const py::array_t<T> open, 
+        py::array_t<T> close, const int trend_period, const std::string type,
+        const float shadow_margin, const py::object out) {
+    if (pattern_direction(type) == Direction::bull) {
+        return kicking_pattern<T, Direction::bull>(high, low, open,
+            close, trend_period, shadow_margin, out);
+    }
+
+    return kicking_pattern<T, Direction::bear>(high, low, open,
+            close, trend_period, shadow_margin, out);
+}
+
 /*
- *  Implementation of PIERCING.
+ *  PIERCING of the price arrays, see piercing_kernel in core/patterns.h.
  *  
  *  Params:
  *      high (py::array_t<T>) : Array with high prices.
@@ -388,37 +361,27 @@ py::array_t<bool> kicking_calc(const py::array_t<T> high,
  *      open (py::array_t<T>) : Array with opening prices.
  *      close (py::array_t<T>) : Array with close prices.
  *      trend_period (int) : Period for moving average in order to identify trend.
+ *      out (py::object) : Array to write the result to, or None.
  */
 template <typename T>
 py::array_t<bool> piercing_calc(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
-        py::array_t<T> close, const int trend_period) {
-
-    const int body_avg_period = 14;
+        py::array_t<T> close, const int trend_period, const py::object out) {
 
     InputContainer<T> data = {high, low, open, close};
-    ResultContainer result_container = {data.size};
-    auto trend = get_trend("sma", close, trend_period);
-    auto body_avg = get_body_avg(open, close, body_avg_period);
-    
-    for (int idx = body_avg_period + 1; idx < data.size; ++idx) {
-        Candlestick<T> candle_prev = {data.high[idx-1], data.low[idx-1], 
-            data.open[idx-1], data.close[idx-1], body_avg[idx-1], trend[idx-1]};
-
-        Candlestick<T> candle = {data.high[idx], data.low[idx], 
-            data.open[idx], data.close[idx], body_avg[idx], trend[idx]};
-    
-        bool correct_cond = piercing_conditions(candle, candle_prev);
-        if (correct_cond) {
-            result_container.found_pattern(idx);
-        }
+    ResultContainer result_container = {data.size, out};
+
+    {
+        py::gil_scoped_release release;
+        piercing_kernel<T>(data.high, data.low, data.open, data.close,
+                result_container.result_ptr, data.size, trend_period);
     }
 
     return result_container.result;
 }
 
 /*
- *  Implementation of THREE WHITE SOLDIERS.
+ *  THREE WHITE SOLDIERS of the price arrays, see tws_kernel in core/patterns.h.
  *  
  *  Params:
  *      high (py::array_t<T>) : Array with high prices.
@@ -426,40 +389,27 @@ py::array_t<bool> piercing_calc(const py::array_t<T> high,
  *      open (py::array_t<T>) : Array with opening prices.
  *      close (py::array_t<T>) : Array with close prices.
  *      trend_period (int) : Period for moving average in order to identify trend.
+ *      out (py::object) : Array to write the result to, or None.
  */
 template <typename T>
 py::array_t<bool> tws_calc(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
-        py::array_t<T> close, const int trend_period) {
-
-    const int body_avg_period = 14;
+        py::array_t<T> close, const int trend_period, const py::object out) {
 
     InputContainer<T> data = {high, low, open, close};
-    ResultContainer result_container = {data.size};
-    auto trend = get_trend("sma", close, trend_period);
-    auto body_avg = get_body_avg(open, close, body_avg_period);
-
-    for (int idx = body_avg_period + 2; idx < data.size; ++idx) {
-        Candlestick<T> c1 = {data.high[idx], data.low[idx], 
-            data.open[idx], data.close[idx], body_avg[idx], trend[idx]};
-
-        Candlestick<T> c2 = {data.high[idx-1], data.low[idx-1], 
-            data.open[idx-1], data.close[idx-1], body_avg[idx-1], trend[idx-1]};
-
-        Candlestick<T> c3 = {data.high[idx-2], data.low[idx-2], 
-            data.open[idx-2], data.close[idx-2], body_avg[idx-2], trend[idx-2]};
+    ResultContainer result_container = {data.size, out};
 
-        auto correct_cond = tws_conditions(c1, c2, c3);
-        if (correct_cond) {
-            result_container.found_pattern(idx);
-        }
+    {
+        py::gil_scoped_release release;
+        tws_kernel<T>(data.high, data.low, data.open, data.close,
+                result_container.result_ptr, data.size, trend_period);
     }
 
-    return result_container.result;;
+    return result_container.result;
 }
 
 /*
- *  Implementation of ABANDONED BABY.
+ *  ABANDONED BABY of the price arrays, see abandoned_baby_kernel in core/patterns.h.
  *  
  *  Params:
  *      high (py::array_t<T>) : Array with high prices.
@@ -467,40 +417,41 @@ py::array_t<bool> tws_calc(const py::array_t<T> high,
  *      open (py::array_t<T>) : Array with opening prices.
  *      close (py::array_t<T>) : Array with close prices.
  *      trend_period (int) : Period for moving average in order to identify trend.
+ *      out (py::object) : Array to write the result to, or None.
  */
-template <typename T>
-py::array_t<bool> abandoned_baby_calc(const py::array_t<T> high, 
+template <typename T, Direction type>
+py::array_t<bool> abandoned_baby_pattern(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
-        py::array_t<T> close, const int trend_period, const std::string type) {
-
-    const int body_avg_period = 14;
+        py::array_t<T> close, const int trend_period, const py::object out) {
 
     InputContainer<T> data = {high, low, open, close};
-    ResultContainer result_container = {data.size};
-    auto trend = get_trend("sma", close, trend_period);
-    auto body_avg = get_body_avg(open, close, body_avg_period);
-
-    for (int idx = body_avg_period + 2; idx < data.size; ++idx) {
-        Candlestick<T> c1 = {data.high[idx], data.low[idx], 
-            data.open[idx], data.close[idx], body_avg[idx], trend[idx]};
+    ResultContainer result_container = {data.size, out};
 
-        Candlestick<T> c2 = {data.high[idx-1], data.low[idx-1], 
-            data.open[idx-1], data.close[idx-1], body_avg[idx-1], trend[idx-1]};
+    {
+        py::gil_scoped_release release;
+        abandoned_baby_kernel<T, type>(data.high, data.low, data.open, data.close,
+                result_container.result_ptr, data.size, trend_period);
+    }
 
-        Candlestick<T> c3 = {data.high[idx-2], data.low[idx-2], 
-            data.open[idx-2], data.close[idx-2], body_avg[idx-2], trend[idx-2]};
+    return result_container.result;
+}
 
-        bool correct_cond = abandoned_baby_conditions(c1, c2, c3, type);
-        if (correct_cond) {
-            result_container.found_pattern(idx);
-        }
+template <typename T>
+py::array_t<bool> abandoned_baby_calc(const py::array_t<T> high, 
+        const py::array_t<T> low, const py::array_t<T> open, 
+        py::array_t<T> close, const int trend_period, const std::string type,
+        const py::object out) {
+    if (pattern_direction(type) == Direction::bull) {
+        return abandoned_baby_pattern<T, Direction::bull>(high, low, open,
+            close, trend_period, out);
     }
 
-    return result_container.result;
+    return abandoned_baby_pattern<T, Direction::bear>(high, low, open,
+            close, trend_period, out);
 }
 
 /*
- *  Implementation of Belt Hold.
+ *  Belt Hold of the price arrays, see belthold_kernel in core/patterns.h.
  *  
  *  Params:
  *      high (py::array_t<T>) : Array with high prices.
@@ -508,35 +459,45 @@ py::array_t<bool> abandoned_baby_calc(const py::array_t<T> high,
  *      open (py::array_t<T>) : Array with opening prices.
  *      close (py::array_t<T>) : Array with close prices.
  *      trend_period (int) : Period for moving average in order to identify trend.
+ *      out (py::object) : Array to write the result to, or None.
  */
-template <typename T>
-py::array_t<bool> belthold_calc(const py::array_t<T> high, 
+template <typename T, Direction type>
+py::array_t<bool> belthold_pattern(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
-        py::array_t<T> close, const int trend_period, const std::string type,
-        const float shadow_margin) {
-
-    const int body_avg_period = 14;
+        py::array_t<T> close, const int trend_period, const float shadow_margin, const py::object out) {
 
     InputContainer<T> data = {high, low, open, close};
-    ResultContainer result_container = {data.size};
-    auto trend = get_trend("sma", close, trend_period);
-    auto body_avg = get_body_avg(open, close, body_avg_period);
-
-    for (int idx = body_avg_period; idx < data.size; ++idx) {
-        Candlestick<T> candle = {data.high[idx], data.low[idx], 
-            data.open[idx], data.close[idx], body_avg[idx], trend[idx]};
-
-        bool correct_cond = belthold_conditions(candle, type, shadow_margin);
-        if (correct_cond) {
-            result_container.found_pattern(idx);
-        }
+    ResultContainer result_container = {data.size, out};
+
+    {
+        py::gil_scoped_release release;
+        belthold_kernel<T, type>(data.high, data.low, data.open, data.close,
+                result_container.result_ptr, data.size, trend_period, shadow_margin);
     }
 
     return result_container.result;
 }
 
+template <typename T>
+py::array_t<bool> belthold_calc(const py::array_t<T> high, 
+        const py::array_t<T> low, const py::array_t<T> open, 
+        py::array_t<T> close, const int trend_period, const std::string type,
+        const float shadow_margin, const py::object out) {
+    if (pattern_direction(type) == Direction::bull) {
+        return belthold_pattern<T, Direction::bull>(high, low, open,
+            close, trend_period, shadow_margin, out);
+    }
 
-PYBIND11_MODULE(_bullish, m) {
+    return belthold_pattern<T, Direction::bear>(high, low, open,
+            close, trend_period, shadow_margin, out);
+}
+
+
+/*
+ *  Bindings of the _bullish submodule, added to the _qufilab extension in
+ *  qufilab/_qufilab.cc.
+ */
+void init_bullish(py::module &m) {
     m.def("hammer_calc", &hammer_calc<double>, "Hammer pattern");
     m.def("hammer_calc", &hammer_calc<double>, "Hammer pattern");
 
@@ -11,65 +11,67 @@ template <typename T>
 py::array_t<bool> hammer_calc(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
         const py::array_t<T> close, const int period, const std::string hammer_type,
-        const T shadow_margin);
+        const T shadow_margin, const py::object out = py::none());
 
 template <typename T>
 py::array_t<bool> dragonfly_doji_calc(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
-        const py::array_t<T> close, const int period);
+        const py::array_t<T> close, const int period, const py::object out = py::none());
 
 template <typename T>
 py::array_t<bool> doji_calc(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
-        const py::array_t<T> close, const int period);
+        const py::array_t<T> close, const int period, const py::object out = py::none());
 
 template <typename T>
 py::array_t<bool> marubozu_white_calc(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
-        const py::array_t<T> close, T shadow_margin, const int period);
+        const py::array_t<T> close, T shadow_margin, const int period,
+        const py::object out = py::none());
 
 template <typename T>
 py::array_t<bool> spinning_top_white_calc(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
-        const py::array_t<T> close, const int period);
+        const py::array_t<T> close, const int period, const py::object out = py::none());
 
 template <typename T>
 py::array_t<bool> engulfing_calc(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
         const py::array_t<T> close, const int trend_period, 
-        const std::string engulfing_type);
+        const std::string engulfing_type, const py::object out = py::none());
 
 template <typename T>
 py::array_t<bool> harami_calc(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
         const py::array_t<T> close, const int trend_period, 
-        const std::string harami_type);
+        const std::string harami_type, const py::object out = py::none());
 
 template <typename T>
 py::array_t<bool> kicking_calc(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
         const py::array_t<T> close, const int trend_period, 
-        const std::string kicking_type, const float shadow_margin);
+        const std::string kicking_type, const float shadow_margin,
+        const py::object out = py::none());
 
 template <typename T>
 py::array_t<bool> piercing_calc(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
-        const py::array_t<T> close, const int trend_period);
-
-template <typename T>
-py::array_t<bool> tws_calc(const py::array_t<T> high, 
-        const py::array_t<T> low, const py::array_t<T> open, 
-        const py::array_t<T> close, const int trend_period);
+        const py::array_t<T> close, const int trend_period,
+        const py::object out = py::none());
 
 template <typename T>
 py::array_t<bool> tws_calc(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
-        const py::array_t<T> close, const int trend_period);
+        const py::array_t<T> close, const int trend_period,
+        const py::object out = py::none());
 
 template <typename T>
 py::array_t<bool> abandoned_baby_calc(const py::array_t<T> high, 
         const py::array_t<T> low, const py::array_t<T> open, 
         const py::array_t<T> close, const int trend_period,
-        const std::string type);
+        const std::string type, const py::object out = py::none());
+
+// Adds the bindings of the module to the submodule m.
+void init_bullish(py::module &m);
 
 #endif
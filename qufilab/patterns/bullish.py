@@ -9,7 +9,7 @@ import numpy as np
 
 from qufilab.patterns._bullish import *
 
-def hammer(high, low, open_, close, periods = 10, shadow_margin = 5.0):
+def hammer(high, low, open_, close, periods = 10, shadow_margin = 5.0, out = None):
     """
     Parameters
     ----------
@@ -27,6 +27,9 @@ def hammer(high, low, open_, close, periods = 10, shadow_margin = 5.0):
         Specify what margin should be allowed for the shadows. By using i.e.
         5%, upper shadow can be as long as 5% of the candlestick body size. 
         This exist to allow some margin and not exclude the shadows entirely.
+    out : `ndarray`, optional
+        Boolean array with the same shape as the prices to write the result
+        to instead of allocating a new one. Defaults to None.
 
     Returns
     -------
@@ -53,10 +56,10 @@ def hammer(high, low, open_, close, periods = 10, shadow_margin = 5.0):
 
     """
     hammer_type = "hammer"
-    hammer = hammer_calc(high, low, open_, close, periods, hammer_type, shadow_margin)
+    hammer = hammer_calc(high, low, open_, close, periods, hammer_type, shadow_margin, out)
     return hammer
     
-def inverted_hammer(high, low, open_, close, periods = 10, shadow_margin = 5.0):
+def inverted_hammer(high, low, open_, close, periods = 10, shadow_margin = 5.0, out = None):
     """
     Parameters
     ----------
@@ -74,6 +77,9 @@ def inverted_hammer(high, low, open_, close, periods = 10, shadow_margin = 5.0):
         Specify what margin should be allowed for the shadows. By using i.e.
         5%, lower shadow can be as long as 5% of the candlestick body size. 
         This exist to allow some margin and not exclude the shadows entirely.
+    out : `ndarray`, optional
+        Boolean array with the same shape as the prices to write the result
+        to instead of allocating a new one. Defaults to None.
 
     Returns
     -------
@@ -94,10 +100,10 @@ def inverted_hammer(high, low, open_, close, periods = 10, shadow_margin = 5.0):
 
     """
     hammer_type = "inverted_hammer"
-    hammer = hammer_calc(high, low, open_, close, periods, hammer_type, shadow_margin)
+    hammer = hammer_calc(high, low, open_, close, periods, hammer_type, shadow_margin, out)
     return hammer
 
-def doji(high, low, open_, close, periods = 10):
+def doji(high, low, open_, close, periods = 10, out = None):
     """
     Parameters
     ----------
@@ -111,6 +117,9 @@ def doji(high, low, open_, close, periods = 10):
         An array containing close prices.
     periods : `int`, optional
         Specifying number of periods for trend identification.
+    out : `ndarray`, optional
+        Boolean array with the same shape as the prices to write the result
+        to instead of allocating a new one. Defaults to None.
 
     Returns
     -------
@@ -129,10 +138,10 @@ def doji(high, low, open_, close, periods = 10):
     [False False False ... False False False]
 
     """
-    doji = doji_calc(high, low, open_, close, periods)
+    doji = doji_calc(high, low, open_, close, periods, out)
     return doji
 
-def dragonfly_doji(high, low, open_, close, periods = 10):
+def dragonfly_doji(high, low, open_, close, periods = 10, out = None):
     """
     Parameters
     ----------
@@ -146,6 +155,9 @@ def dragonfly_doji(high, low, open_, close, periods = 10):
         An array containing close prices.
     periods : `int`, optional
         Specifying number of periods for trend identification.
+    out : `ndarray`, optional
+        Boolean array with the same shape as the prices to write the result
+        to instead of allocating a new one. Defaults to None.
 
     Returns
     -------
@@ -164,10 +176,10 @@ def dragonfly_doji(high, low, open_, close, periods = 10):
     [False False False ... False False False]
 
     """
-    dragonfly_doji = dragonfly_doji_calc(high, low, open_, close, periods)
+    dragonfly_doji = dragonfly_doji_calc(high, low, open_, close, periods, out)
     return dragonfly_doji
 
-def marubozu_white(high, low, open_, close, shadow_margin = 5.0, periods = 10):
+def marubozu_white(high, low, open_, close, shadow_margin = 5.0, periods = 10, out = None):
     """
     Parameters
     ----------
@@ -186,6 +198,9 @@ def marubozu_white(high, low, open_, close, shadow_margin = 5.0, periods = 10):
         restrict to no shadow).
     periods : `int`, optional
         Specifying number of periods for trend identification.
+    out : `ndarray`, optional
+        Boolean array with the same shape as the prices to write the result
+        to instead of allocating a new one. Defaults to None.
 
     Returns
     -------
@@ -203,10 +218,10 @@ def marubozu_white(high, low, open_, close, shadow_margin = 5.0, periods = 10):
     >>> print(marubozu_white)
     [False False False ... False False False]
     """
-    marubozu_white = marubozu_white_calc(high, low, open_, close, shadow_margin, periods)
+    marubozu_white = marubozu_white_calc(high, low, open_, close, shadow_margin, periods, out)
     return marubozu_white
 
-def marubozu_black(high, low, open_, close, shadow_margin = 5.0, periods = 10):
+def marubozu_black(high, low, open_, close, shadow_margin = 5.0, periods = 10, out = None):
     """
     Parameters
     ----------
@@ -225,6 +240,9 @@ def marubozu_black(high, low, open_, close, shadow_margin = 5.0, periods = 10):
         restrict to no shadow).
     periods : `int`, optional
         Specifying number of periods for trend identification.
+    out : `ndarray`, optional
+        Boolean array with the same shape as the prices to write the result
+        to instead of allocating a new one. Defaults to None.
 
     Returns
     -------
@@ -232,10 +250,10 @@ def marubozu_black(high, low, open_, close, shadow_margin = 5.0, periods = 10):
         A numpy ndarray of type bool specifying true whether
         a pattern has been found or false otherwise. 
     """
-    pattern = marubozu_black_calc(high, low, open_, close, shadow_margin, periods)
+    pattern = marubozu_black_calc(high, low, open_, close, shadow_margin, periods, out)
     return pattern
 
-def spinning_top_white(high, low, open_, close, periods = 10):
+def spinning_top_white(high, low, open_, close, periods = 10, out = None):
     """
     Parameters
     ----------
@@ -249,6 +267,9 @@ def spinning_top_white(high, low, open_, close, periods = 10):
         An array containing close prices.
     periods : `int`, optional
         Specifying number of periods for trend identification.
+    out : `ndarray`, optional
+        Boolean array with the same shape as the prices to write the result
+        to instead of allocating a new one. Defaults to None.
 
     Returns
     -------
@@ -256,10 +277,10 @@ def spinning_top_white(high, low, open_, close, periods = 10):
         A numpy ndarray of type bool specifying true whether
         a pattern has been found or false otherwise. 
     """
-    spinning_top_white = spinning_top_white_calc(high, low, open_, close, periods)
+    spinning_top_white = spinning_top_white_calc(high, low, open_, close, periods, out)
     return spinning_top_white
 
-def engulfing_bull(high, low, open_, close, periods = 10):
+def engulfing_bull(high, low, open_, close, periods = 10, out = None):
     """
     Parameters
     ----------
@@ -273,6 +294,9 @@ def engulfing_bull(high, low, open_, close, periods = 10):
         An array containing close prices.
     periods : `int`, optional
         Specifying number of periods for trend identification.
+    out : `ndarray`, optional
+        Boolean array with the same shape as the prices to write the result
+        to instead of allocating a new one. Defaults to None.
 
     Returns
     -------
@@ -282,10 +306,10 @@ def engulfing_bull(high, low, open_, close, periods = 10):
 
     """
     engulfing_type = "bull"
-    engulfing = engulfing_calc(high, low, open_, close, periods, engulfing_type)
+    engulfing = engulfing_calc(high, low, open_, close, periods, engulfing_type, out)
     return engulfing
 
-def engulfing_bear(high, low, open_, close, periods = 10):
+def engulfing_bear(high, low, open_, close, periods = 10, out = None):
     """
     Parameters
     ----------
@@ -299,6 +323,9 @@ def engulfing_bear(high, low, open_, close, periods = 10):
         An array containing close prices.
     periods : `int`, optional
         Specifying number of periods for trend identification.
+    out : `ndarray`, optional
+        Boolean array with the same shape as the prices to write the result
+        to instead of allocating a new one. Defaults to None.
 
     Returns
     -------
@@ -307,10 +334,10 @@ def engulfing_bear(high, low, open_, close, periods = 10):
         a pattern has been found or false otherwise. 
     """
     engulfing_type = "bear"
-    engulfing = engulfing_calc(high, low, open_, close, periods, engulfing_type)
+    engulfing = engulfing_calc(high, low, open_, close, periods, engulfing_type, out)
     return engulfing
 
-def harami_bull(high, low, open_, close, periods = 10):
+def harami_bull(high, low, open_, close, periods = 10, out = None):
     """
     Parameters
     ----------
@@ -324,6 +351,9 @@ def harami_bull(high, low, open_, close, periods = 10):
         An array containing close prices.
     periods : `int`, optional
         Specifying number of periods for trend identification.
+    out : `ndarray`, optional
+        Boolean array with the same shape as the prices to write the result
+        to instead of allocating a new one. Defaults to None.
 
     Returns
     -------
@@ -332,10 +362,10 @@ def harami_bull(high, low, open_, close, periods = 10):
         a pattern has been found or false otherwise. 
     """
     harami_type = "bull"
-    harami = harami_calc(high, low, open_, close, periods, harami_type)
+    harami = harami_calc(high, low, open_, close, periods, harami_type, out)
     return harami
 
-def harami_bear(high, low, open_, close, periods = 10):
+def harami_bear(high, low, open_, close, periods = 10, out = None):
     """
     Parameters
     ----------
@@ -349,6 +379,9 @@ def harami_bear(high, low, open_, close, periods = 10):
         An array containing close prices.
     periods : `int`, optional
         Specifying number of periods for trend identification.
+    out : `ndarray`, optional
+        Boolean array with the same shape as the prices to write the result
+        to instead of allocating a new one. Defaults to None.
 
     Returns
     -------
@@ -357,10 +390,10 @@ def harami_bear(high, low, open_, close, periods = 10):
         a pattern has been found or false otherwise. 
     """
     harami_type = "bear"
-    harami = harami_calc(high, low, open_, close, periods, harami_type)
+    harami = harami_calc(high, low, open_, close, periods, harami_type, out)
     return harami
 
-def kicking_bull(high, low, open_, close, periods = 10, shadow_margin = 5.0):
+def kicking_bull(high, low, open_, close, periods = 10, shadow_margin = 5.0, out = None):
     """
     Parameters
     ----------
@@ -379,6 +412,9 @@ def kicking_bull(high, low, open_, close, periods = 10, shadow_margin = 5.0):
         example 5%, both the lower and upper shadow can be as high as 5%
         of the candlestick body size. This exist to allow some margin (not
         restrict to no shadow).
+    out : `ndarray`, optional
+        Boolean array with the same shape as the prices to write the result
+        to instead of allocating a new one. Defaults to None.
 
     Returns
     -------
@@ -387,10 +423,10 @@ def kicking_bull(high, low, open_, close, periods = 10, shadow_margin = 5.0):
         a pattern has been found or false otherwise. 
     """
     kicking_type = "bull"
-    kicking = kicking_calc(high, low, open_, close, periods, kicking_type, shadow_margin)
+    kicking = kicking_calc(high, low, open_, close, periods, kicking_type, shadow_margin, out)
     return kicking
     
-def kicking_bear(high, low, open_, close, periods = 10, shadow_margin = 5.0):
+def kicking_bear(high, low, open_, close, periods = 10, shadow_margin = 5.0, out = None):
     """
     Parameters
     ----------
@@ -409,6 +445,9 @@ def kicking_bear(high, low, open_, close, periods = 10, shadow_margin = 5.0):
         example 5%, both the lower and upper shadow can be as high as 5%
         of the candlestick body size. This exist to allow some margin (not
         restrict to no shadow).
+    out : `ndarray`, optional
+        Boolean array with the same shape as the prices to write the result
+        to instead of allocating a new one. Defaults to None.
 
     Returns
     -------
@@ -417,10 +456,10 @@ def kicking_bear(high, low, open_, close, periods = 10, shadow_margin = 5.0):
         a pattern has been found or false otherwise. 
     """
     kicking_type = "bear"
-    kicking = kicking_calc(high, low, open_, close, periods, kicking_type, shadow_margin)
+    kicking = kicking_calc(high, low, open_, close, periods, kicking_type, shadow_margin, out)
     return kicking
 
-def piercing(high, low, open_, close, periods = 10):
+def piercing(high, low, open_, close, periods = 10, out = None):
     """
     Parameters
     ----------
@@ -434,6 +473,9 @@ def piercing(high, low, open_, close, periods = 10):
         An array containing close prices.
     periods : `int`, optional
         Specifying number of periods for trend identification.
+    out : `ndarray`, optional
+        Boolean array with the same shape as the prices to write the result
+        to instead of allocating a new one. Defaults to None.
 
     Returns
     -------
@@ -441,10 +483,10 @@ def piercing(high, low, open_, close, periods = 10):
         A numpy ndarray of type bool specifying true whether
         a pattern has been found or false otherwise. 
     """
-    piercing = piercing_calc(high, low, open_, close, periods)
+    piercing = piercing_calc(high, low, open_, close, periods, out)
     return piercing
 
-def tws(high, low, open_, close, periods = 10):
+def tws(high, low, open_, close, periods = 10, out = None):
     """
     Three White Soldiers
 
@@ -460,6 +502,9 @@ def tws(high, low, open_, close, periods = 10):
         An array containing close prices.
     periods : `int`, optional
         Specifying number of periods for trend identification.
+    out : `ndarray`, optional
+        Boolean array with the same shape as the prices to write the result
+        to instead of allocating a new one. Defaults to None.
 
     Returns
     -------
@@ -467,10 +512,10 @@ def tws(high, low, open_, close, periods = 10):
         A numpy ndarray of type bool specifying true whether
         a pattern has been found or false otherwise. 
     """
-    tws = tws_calc(high, low, open_, close, periods)
+    tws = tws_calc(high, low, open_, close, periods, out)
     return tws
 
-def abandoned_baby_bull(high, low, open_, close, periods = 10):
+def abandoned_baby_bull(high, low, open_, close, periods = 10, out = None):
     """
     Abandoned Baby Bull
 
@@ -486,6 +531,9 @@ def abandoned_baby_bull(high, low, open_, close, periods = 10):
         An array containing close prices.
     periods : `int`, optional
         Specifying number of periods for trend identification.
+    out : `ndarray`, optional
+        Boolean array with the same shape as the prices to write the result
+        to instead of allocating a new one. Defaults to None.
 
     Returns
     -------
@@ -494,10 +542,10 @@ def abandoned_baby_bull(high, low, open_, close, periods = 10):
         a pattern has been found or false otherwise. 
     """
     type_ = "bull"
-    pattern = abandoned_baby_calc(high, low, open_, close, periods, type_)
+    pattern = abandoned_baby_calc(high, low, open_, close, periods, type_, out)
     return pattern
 
-def abandoned_baby_bear(high, low, open_, close, periods = 10):
+def abandoned_baby_bear(high, low, open_, close, periods = 10, out = None):
     """
     Abandoned Baby Bear
 
@@ -513,6 +561,9 @@ def abandoned_baby_bear(high, low, open_, close, periods = 10):
         An array containing close prices.
     periods : `int`, optional
         Specifying number of periods for trend identification.
+    out : `ndarray`, optional
+        Boolean array with the same shape as the prices to write the result
+        to instead of allocating a new one. Defaults to None.
 
     Returns
     -------
@@ -521,11 +572,11 @@ def abandoned_baby_bear(high, low, open_, close, periods = 10):
         a pattern has been found or false otherwise. 
     """
     type_ = "bear"
-    pattern = abandoned_baby_calc(high, low, open_, close, periods, type_)
+    pattern = abandoned_baby_calc(high, low, open_, close, periods, type_, out)
     return pattern
 
 
-def belthold_bull(high, low, open_, close, periods = 10, shadow_margin = 5.0):
+def belthold_bull(high, low, open_, close, periods = 10, shadow_margin = 5.0, out = None):
     """
     Belt Hold Bull
 
@@ -546,6 +597,9 @@ def belthold_bull(high, low, open_, close, periods = 10, shadow_margin = 5.0):
         example 5%, both the lower and upper shadow can be as high as 5%
         of the candlestick body size. This exist to allow some margin (not
         restrict to no shadow).
+    out : `ndarray`, optional
+        Boolean array with the same shape as the prices to write the result
+        to instead of allocating a new one. Defaults to None.
 
     Returns
     -------
@@ -554,11 +608,11 @@ def belthold_bull(high, low, open_, close, periods = 10, shadow_margin = 5.0):
         a pattern has been found or false otherwise. 
     """
     type_ = "bull"
-    pattern = belthold_calc(high, low, open_, close, periods, type_, shadow_margin)
+    pattern = belthold_calc(high, low, open_, close, periods, type_, shadow_margin, out)
     return pattern
     
 
-def belthold_bear(high, low, open_, close, periods = 10, shadow_margin = 5.0):
+def belthold_bear(high, low, open_, close, periods = 10, shadow_margin = 5.0, out = None):
     """
     Belt Hold Bear
 
@@ -579,6 +633,9 @@ def belthold_bear(high, low, open_, close, periods = 10, shadow_margin = 5.0):
         example 5%, both the lower and upper shadow can be as high as 5%
         of the candlestick body size. This exist to allow some margin (not
         restrict to no shadow).
+    out : `ndarray`, optional
+        Boolean array with the same shape as the prices to write the result
+        to instead of allocating a new one. Defaults to None.
 
     Returns
     -------
@@ -587,5 +644,5 @@ def belthold_bear(high, low, open_, close, periods = 10, shadow_margin = 5.0):
         a pattern has been found or false otherwise. 
     """
     type_ = "bear"
-    pattern = belthold_calc(high, low, open_, close, periods, type_, shadow_margin)
+    pattern = belthold_calc(high, low, open_, close, periods, type_, shadow_margin, out)
     return pattern
@@ -5,7 +5,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/numpy.h>
 
-#include "../indicators/util.h"
+#include "../indicators/panel.h"
 
 namespace py = pybind11;
 
@@ -38,18 +38,18 @@ struct InputContainer{
     }
 };
 
+/*
+ *  Boolean result of a pattern, written to out if it is given (see
+ *  output_array in panel.h). The pattern kernels set every index, so the
+ *  result is not cleared in advance.
+ */
 struct ResultContainer {
     py::array_t<bool> result;
     bool *result_ptr;
 
-    ResultContainer(int size) {
-        result = py::array_t<bool>(size);
-        result_ptr = (bool *) result.request().ptr;
-        init_false(result_ptr, size);
-    }
-
-    void found_pattern(int idx) {
-        result_ptr[idx] = true;
+    ResultContainer(int size, const py::object &out) {
+        result = output_array<bool>(out, {size}, true);
+        result_ptr = (bool *) result.request(true).ptr;
     }
 };
 
@@ -5,6 +5,7 @@ import sys
 import platform
 import subprocess
 
+import setuptools
 from setuptools import setup, Extension, find_packages
 from setuptools.command.build_ext import build_ext
 from distutils.version import LooseVersion
@@ -101,6 +102,15 @@ class BuildExt(build_ext):
             opts.append(cpp_flag(self.compiler))
             if has_flag(self.compiler, '-fvisibility=hidden'):
                 opts.append('-fvisibility=hidden')
+            # The SIMD variants in simd.h are compiled for AVX2/AVX-512 with
+            # target attributes, this keeps them from fusing a*b + c so they
+            # give the same results as the baseline build.
+            if has_flag(self.compiler, '-ffp-contract=off'):
+                opts.append('-ffp-contract=off')
+            # OpenMP is optional, without it the parallel loops run serially.
+            if has_flag(self.compiler, '-fopenmp'):
+                opts.append('-fopenmp')
+                link_opts.append('-fopenmp')
 
         for ext in self.extensions:
             ext.define_macros = [('VERSION_INFO', '"{}"'.format(self.distribution.get_version()))]
@@ -109,16 +119,13 @@ class BuildExt(build_ext):
         build_ext.build_extensions(self)
 
 """
-Each individual extension, i.e. .so file that needs to be compiled and created
-in order for the qufilab package to successfully import these files needs to be
-included below.
-Each extension needs to have it's included source files, i.e. .cc files (check
-implementation and see which files needs to be included).
-
-OBSERVE! If the source-files haven't been included correctly, python will
-raise an ImportError. For example, if 'stat' extension doesn't include 
-'trend.cc' sourcefile, the function 'std (standard deviation)' won't work since it
-depends on functions from the trend source file.
+The indicator and pattern modules are compiled into a single extension,
+qufilab._qufilab, with one submodule per module (see qufilab/_qufilab.cc).
+The kernels in qufilab/core are header-only, so every module is compiled
+once and the shared code is loaded once when qufilab is imported.
+
+OBSERVE! A new module needs its .cc file included below, and its submodule
+added in qufilab/_qufilab.cc, otherwise python will raise an ImportError.
 """
 ext_modules = [
     # Models extension
@@ -133,63 +140,16 @@ ext_modules = [
     #    ],
     #    language='c++'
     #),
-    # Trend extension
-    Extension(
-        'qufilab.indicators._trend',
-        sorted(['qufilab/indicators/_trend.cc']),
-        include_dirs=[
-            get_pybind_include(),
-        ],
-        language='c++'
-    ),
-    # Volatility extension
+    # Indicators and patterns extension
     Extension(
-        'qufilab.indicators._volatility',
-        sorted(['qufilab/indicators/_volatility.cc',
+        'qufilab._qufilab',
+        sorted(['qufilab/_qufilab.cc',
             'qufilab/indicators/_trend.cc',
-            'qufilab/indicators/_stat.cc']),
-        include_dirs=[
-            get_pybind_include(),
-        ],
-        language='c++'
-    ),
-    ## Momentum extension
-    Extension(
-        'qufilab.indicators._momentum',
-        sorted(['qufilab/indicators/_momentum.cc',
-            'qufilab/indicators/_trend.cc']),
-        include_dirs=[
-            get_pybind_include(),
-        ],
-        language='c++'
-    ),
-    ## Volume extension
-    Extension(
-        'qufilab.indicators._volume',
-        sorted(['qufilab/indicators/_volume.cc',
-            'qufilab/indicators/_trend.cc']),
-        include_dirs=[
-            get_pybind_include(),
-        ],
-        language='c++'
-    ),
-    ## Stat extension
-    Extension(
-        'qufilab.indicators._stat',
-        sorted(['qufilab/indicators/_stat.cc',
-            'qufilab/indicators/_trend.cc']),
-        include_dirs=[
-            get_pybind_include(),
-        ],
-        language='c++'
-    ),
-    # Patterns
-    ## Bullish extension
-    Extension(
-        'qufilab.patterns._bullish',
-        sorted(['qufilab/patterns/_bullish.cc',
-            'qufilab/patterns/candlestick.cc',
-            'qufilab/indicators/_trend.cc']),
+            'qufilab/indicators/_volatility.cc',
+            'qufilab/indicators/_momentum.cc',
+            'qufilab/indicators/_volume.cc',
+            'qufilab/indicators/_stat.cc',
+            'qufilab/patterns/_bullish.cc']),
         include_dirs=[
             get_pybind_include(),
         ],
@@ -64,6 +64,18 @@ class TestQuant(unittest.TestCase):
         t3_talib = talib.T3(self.close, periods)
         np.testing.assert_allclose(t3, t3_talib, rtol = self.tolerance)
 
+    def test_ema_cascade_period(self):
+        """
+        Test that DEMA, TEMA and T3 are NaN for a period below 1, for a single
+        series and a panel.
+        """
+        close = self.close[:1000]
+        panel = self.close[:1000].reshape(-1, 4)
+        for func in [qufilab.dema, qufilab.tema, qufilab.t3]:
+            for period in [0, -3]:
+                self.assertTrue(np.isnan(func(close, period)).all())
+                self.assertTrue(np.isnan(func(panel, period)).all())
+
     def test_tma(self):
         """
         Test Triangular Moving Average.
@@ -81,7 +93,104 @@ class TestQuant(unittest.TestCase):
         lwma = qufilab.lwma(self.close, periods)
         lwma_talib = talib.WMA(self.close, periods)
         np.testing.assert_allclose(lwma, lwma_talib, rtol = self.tolerance)
-    
+
+    def test_lwma_leading_nan(self):
+        """
+        Test linear weighted moving average on data with leading NaNs.
+        """
+        periods = 200
+        data = np.concatenate(([np.nan] * 50, self.close[:10000]))
+        lwma = qufilab.lwma(data, periods)
+        np.testing.assert_allclose(lwma[50:], qufilab.lwma(self.close[:10000], periods), 
+                rtol = self.tolerance)
+        self.assertTrue(np.isnan(lwma[:50 + periods - 1]).all())
+
+    def test_lwma_drift(self):
+        """
+        Test linear weighted moving average after a jump in the level of the
+        prices, against a naive implementation weighting every window, and
+        with a period below 1.
+        """
+        periods = 20
+        data = np.concatenate((self.close[:5000] * 1e8, self.close[:5000]))
+        weights = np.arange(1, periods + 1)
+        naive = np.array([np.dot(data[idx - periods + 1:idx + 1], weights) / weights.sum()
+            for idx in range(periods - 1, len(data))])
+        lwma = qufilab.lwma(data, periods)[periods - 1:]
+        np.testing.assert_allclose(lwma[:5000 - periods], naive[:5000 - periods], rtol = 1e-12)
+        # Windows after the jump, from the first recalculation of the sums.
+        np.testing.assert_allclose(lwma[5000:], naive[5000:], rtol = 1e-12)
+
+        state = qufilab.LwmaState(periods)
+        np.testing.assert_array_equal(state.update_many(data), qufilab.lwma(data, periods))
+
+        self.assertTrue(np.isnan(qufilab.lwma(self.close[:100], 0)).all())
+
+    def test_sma_multi(self):
+        """
+        Test simple moving average for multiple periods.
+        """
+        periods = [5, 20, 200]
+        q = qufilab.sma_multi(self.close, periods)
+        for idx, period in enumerate(periods):
+            np.testing.assert_allclose(q[idx], talib.SMA(self.close, period), rtol = self.tolerance)
+
+    def test_ema_multi(self):
+        """
+        Test exponential moving average for multiple periods.
+        """
+        periods = [5, 20, 200]
+        q = qufilab.ema_multi(self.close, periods)
+        for idx, period in enumerate(periods):
+            np.testing.assert_allclose(q[idx], talib.EMA(self.close, period), rtol = self.tolerance)
+
+    def test_lwma_multi(self):
+        """
+        Test linear weighted moving average for multiple periods.
+        """
+        periods = [5, 20, 200]
+        q = qufilab.lwma_multi(self.close, periods)
+        for idx, period in enumerate(periods):
+            np.testing.assert_allclose(q[idx], talib.WMA(self.close, period), rtol = self.tolerance)
+
+    def test_lwma_multi_long(self):
+        """
+        Test linear weighted moving average for multiple periods on a long
+        series against the single period version, including periods longer
+        than the blocks of the weighted prefix sums.
+        """
+        close = self.close * 100 + 100
+        periods = [1, 5, 20, 5000]
+        q = qufilab.lwma_multi(close, periods)
+        for idx, period in enumerate(periods):
+            np.testing.assert_allclose(q[idx], qufilab.lwma(close, period), rtol = 1e-11)
+
+    def test_multi_period_below_one(self):
+        """
+        Test that the multi period kernels give NaN rows for periods below 1,
+        which the python functions reject before calling them.
+        """
+        close = self.close[:1000]
+        trend = qufilab.indicators._trend
+        for calc, func in [(trend.sma_multi_calc, qufilab.sma), (trend.ema_multi_calc, qufilab.ema),
+                (trend.lwma_multi_calc, qufilab.lwma)]:
+            q = calc(close, [0, 5, -3], None)
+            self.assertTrue(np.isnan(q[[0, 2]]).all())
+            np.testing.assert_allclose(q[1], func(close, 5), rtol = 1e-12)
+
+    def test_multi_strided(self):
+        """
+        Test the moving averages for multiple periods with strided input,
+        which is copied, and 2D input, which isn't supported.
+        """
+        close = self.close[:20000:2]
+        panel = np.column_stack([self.close[:10000], self.high[:10000]])
+        for func in [qufilab.sma_multi, qufilab.ema_multi, qufilab.lwma_multi]:
+            np.testing.assert_array_equal(func(close, [5, 20]), func(close.copy(), [5, 20]))
+            np.testing.assert_array_equal(func(panel[:, 1], [5]), func(panel[:, 1].copy(), [5]))
+            with self.assertRaises(ValueError):
+                func(panel, [5])
+
     def test_wc(self):
         """ 
         Test weighted close.
@@ -89,7 +198,70 @@ class TestQuant(unittest.TestCase):
         wc_qufilab = qufilab.wc(self.high, self.low, self.close)
         wc_talib = talib.WCLPRICE(self.high, self.low, self.close)
         np.testing.assert_allclose(wc_qufilab, wc_talib, rtol = self.tolerance)
-        
+
+    def test_sma_state(self):
+        """
+        Test streaming Simple Moving Average against the batch version.
+        """
+        periods = 200
+        state = qufilab.SmaState(periods)
+        q = state.update_many(self.close[:5000])
+        q = np.append(q, [state.update(price) for price in self.close[5000:6000]])
+        np.testing.assert_array_equal(q, qufilab.sma(self.close[:6000], periods))
+
+        # Beyond the chunks of the windowed indicators, see halo.h.
+        state = qufilab.SmaState(periods)
+        np.testing.assert_array_equal(state.update_many(self.close), qufilab.sma(self.close, periods))
+
+    def test_ema_state(self):
+        """
+        Test streaming Exponential Moving Average against the batch version.
+        """
+        periods = 200
+        state = qufilab.EmaState(periods)
+        q = state.update_many(self.close[:5000])
+        q = np.append(q, [state.update(price) for price in self.close[5000:6000]])
+        np.testing.assert_array_equal(q, qufilab.ema(self.close[:6000], periods))
+
+    def test_smma_state(self):
+        """
+        Test streaming Smoothed Moving Average against the batch version.
+        """
+        periods = 200
+        state = qufilab.SmmaState(periods)
+        q = state.update_many(self.close[:5000])
+        q = np.append(q, [state.update(price) for price in self.close[5000:6000]])
+        np.testing.assert_array_equal(q, qufilab.smma(self.close[:6000], periods))
+
+    def test_lwma_state(self):
+        """
+        Test streaming Linear Weighted Moving Average against the batch version.
+        """
+        periods = 200
+        state = qufilab.LwmaState(periods)
+        q = state.update_many(self.close[:5000])
+        q = np.append(q, [state.update(price) for price in self.close[5000:6000]])
+        np.testing.assert_array_equal(q, qufilab.lwma(self.close[:6000], periods))
+
+    def test_state_input(self):
+        """
+        Test streaming states with strided prices, a 2D array and invalid
+        periods.
+        """
+        periods = 20
+        for state_type, calc in [(qufilab.SmaState, qufilab.sma),
+                (qufilab.EmaState, qufilab.ema), (qufilab.SmmaState, qufilab.smma),
+                (qufilab.LwmaState, qufilab.lwma)]:
+            q = state_type(periods).update_many(self.close[:2000:2])
+            np.testing.assert_array_equal(q, calc(np.ascontiguousarray(self.close[:2000:2]), periods))
+
+            with self.assertRaises(ValueError):
+                state_type(periods).update_many(self.close[:200].reshape(100, 2))
+
+            for invalid in [0, -1]:
+                with self.assertRaises(ValueError):
+                    state_type(invalid)
+
     def test_rsi(self):
         """
         Test relative strength index.
@@ -99,6 +271,27 @@ class TestQuant(unittest.TestCase):
         rsi_talib = talib.RSI(self.close, periods)
         np.testing.assert_allclose(rsi_qufilab, rsi_talib, rtol = self.tolerance)
 
+        with self.assertRaises(ValueError):
+            qufilab.rsi(self.close, periods, "wilder")
+
+    def test_rsi_standard(self):
+        """
+        Test relative strength index with simple averages over the window,
+        against a naive implementation averaging every window.
+        """
+        periods = 14
+        close = self.close[:5000]
+        rsi_naive = np.full(close.shape, np.nan)
+        for idx in range(periods, len(close)):
+            diff = np.diff(close[idx - periods:idx + 1])
+            avg_gain = diff[diff > 0].sum() / periods
+            avg_loss = -diff[diff < 0].sum() / periods
+            rsi_naive[idx] = 100 - 100 / (1 + avg_gain / avg_loss)
+
+        for rsi_type in ["standard", "cutler"]:
+            rsi_qufilab = qufilab.rsi(close, periods, rsi_type)
+            np.testing.assert_allclose(rsi_qufilab, rsi_naive, rtol = self.tolerance)
+
     def test_william_r(self):
         """
         Test William's %R.
@@ -126,6 +319,19 @@ class TestQuant(unittest.TestCase):
         t = talib.ROC(self.close, periods)
         np.testing.assert_allclose(q, t, rtol = self.tolerance)
 
+    def test_period_below_one(self):
+        """
+        Test that roc, mi, pct_change, apo and cv are NaN for a period below
+        1.
+        """
+        close, high, low = self.close[:1000], self.high[:1000], self.low[:1000]
+        for period in [0, -3]:
+            for q in [qufilab.roc(close, period), qufilab.mi(close, period),
+                    qufilab.pct_change(close, period), qufilab.apo(close, period, 12),
+                    qufilab.apo(close, 26, period, "ema"), qufilab.cv(high, low, 10, period),
+                    qufilab.cv(high, low, period, 10)]:
+                self.assertTrue(np.isnan(q).all())
+
     def test_aroon(self):
         """
         Test Aroon oscillator.
@@ -143,6 +349,102 @@ class TestQuant(unittest.TestCase):
         t = talib.OBV(self.close, self.volume)
         np.testing.assert_allclose(q, t, rtol = self.tolerance)
 
+    def test_scan(self):
+        """
+        Test that the cumulative indicators, calculated in parallel blocks
+        for a single series, give the same values as the series of a panel.
+        """
+        close = np.column_stack([self.close, self.close[::-1]])
+        volume = np.column_stack([self.volume, self.volume[::-1]])
+        for func in [qufilab.obv, qufilab.vpt, qufilab.pvi, qufilab.nvi]:
+            q = func(close, volume)
+            np.testing.assert_array_equal(q[:, 0], func(self.close, self.volume))
+            np.testing.assert_array_equal(q[:, 1], func(self.close[::-1], self.volume[::-1]))
+
+    def test_halo(self):
+        """
+        Test that the windowed indicators, calculated in chunks for a single
+        long series, give the same values as a shorter series calculated by
+        the serial loop. willr and cmf are exact, the others restart their
+        running sums in each chunk.
+        """
+        period = 21
+        start = period * 38096
+        close, high, low = self.close, self.high, self.low
+        volume = self.volume
+        cases = [
+            (lambda c, h, l, v: qufilab.willr(c, h, l, period), 0),
+            (lambda c, h, l, v: qufilab.cmf(c, h, l, v, period), 0),
+            (lambda c, h, l, v: qufilab.cmo(c, period), 1e-10),
+            (lambda c, h, l, v: qufilab.mfi(h, l, c, v, period), 1e-10),
+            (lambda c, h, l, v: qufilab.cci(c, h, l, period), 1e-10),
+        ]
+
+        for func, rtol in cases:
+            q = func(close, high, low, volume)
+            q_serial = func(close[start:], high[start:], low[start:], volume[start:])
+            np.testing.assert_allclose(q[start + period:], q_serial[period:],
+                    rtol = rtol, atol = rtol)
+
+        # Series with leading NaNs or an infinite value are calculated by the
+        # serial loop.
+        leading = np.concatenate(([np.nan] * 50, close))
+        q = qufilab.cci(leading, leading, leading, period)
+        np.testing.assert_allclose(q[50 + period:], qufilab.cci(close, close, close, period)[period:],
+                rtol = 1e-10, atol = 1e-10)
+        infinite = close.copy()
+        infinite[start] = np.inf
+        self.assertTrue(np.isnan(qufilab.cci(infinite, infinite, infinite, period)[start + period:]).all())
+
+    def test_affine_scan(self):
+        """
+        Test that the smoothed indicators, calculated in parallel blocks for
+        a single long series, stay close to the serial recurrences of the
+        lanes kernels.
+        """
+        size = 200000
+        close = np.column_stack([np.roll(self.close, col)[:size] for col in range(16)])
+        high = np.column_stack([np.roll(self.high, col)[:size] for col in range(16)])
+        low = np.column_stack([np.roll(self.low, col)[:size] for col in range(16)])
+        ema = qufilab.ema(close, 20)
+        smma = qufilab.smma(close, 20)
+        rsi = qufilab.rsi(close, 14)
+        atr = qufilab.atr(close, high, low, 14)
+
+        for col in [0, 15]:
+            np.testing.assert_allclose(qufilab.ema(close[:, col].copy(), 20), ema[:, col], rtol = 1e-12)
+            np.testing.assert_allclose(qufilab.smma(close[:, col].copy(), 20), smma[:, col], rtol = 1e-12)
+            np.testing.assert_allclose(qufilab.rsi(close[:, col].copy(), 14), rsi[:, col], rtol = 1e-12)
+            np.testing.assert_allclose(qufilab.atr(close[:, col].copy(), high[:, col].copy(),
+                low[:, col].copy(), 14), atr[:, col], rtol = 1e-12)
+
+    def test_scan_serial(self):
+        """
+        Test the serial recurrences of the states, lanes and ema cascades
+        against the kernels calculated in parallel blocks, which are the same
+        for the first 65536 values of the smoothing and close after them.
+        """
+        size, block, periods = 200000, 65536, 20
+        close = self.close[:size]
+        first = periods - 1 + block
+        pairs = [(qufilab.EmaState(periods).update_many(close), qufilab.ema(close, periods)),
+            (qufilab.SmmaState(periods).update_many(close), qufilab.smma(close, periods))]
+
+        # Columns 0-15 are calculated by the lanes kernel, column 16 by itself.
+        panel = np.column_stack([np.roll(close, col) for col in range(17)])
+        ema = qufilab.ema(panel, periods)
+        pairs.append((ema[:, 0], qufilab.ema(panel[:, 0].copy(), periods)))
+        np.testing.assert_array_equal(ema[:, 16], qufilab.ema(panel[:, 16].copy(), periods))
+
+        ema_close = qufilab.ema(close, periods)
+        dema = 2 * ema_close - qufilab.ema(ema_close, periods)
+        pairs.append((qufilab.dema(close, periods), dema))
+
+        for serial, blocked in pairs:
+            np.testing.assert_array_equal(serial[:first], blocked[:first])
+            np.testing.assert_allclose(serial[first:], blocked[first:], rtol = 1e-12)
+            self.assertFalse(np.isnan(serial[2 * periods:]).any())
+
     def test_cci(self):
         """
         Test Commodity Channel Index.
@@ -167,6 +469,22 @@ class TestQuant(unittest.TestCase):
         t = talib.VAR(self.close, 200)
         np.testing.assert_allclose(q, t, rtol = self.tolerance)
 
+    def test_var_nan(self):
+        """
+        Test Variance with NaNs, which give NaN for the windows containing
+        them.
+        """
+        periods = 20
+        close = self.close[:2000].copy()
+        close[:5] = np.nan
+        close[1000] = np.nan
+
+        q = qufilab.var(close, periods)
+        t = np.full(close.shape, np.nan)
+        for idx in range(periods - 1, len(close)):
+            t[idx] = np.var(close[idx - periods + 1:idx + 1], ddof = 1)
+        np.testing.assert_allclose(q, t, rtol = self.tolerance)
+
     def test_beta(self):
         """
         Test Beta.
@@ -175,6 +493,128 @@ class TestQuant(unittest.TestCase):
         t = talib.BETA(self.high, self.close, 200)
         np.testing.assert_allclose(q, t, rtol = self.tolerance)
 
+    def test_corr(self):
+        """
+        Test Correlation.
+        """
+        q = qufilab.corr(self.close, self.high, 200)
+        t = talib.CORREL(self.close, self.high, 200)
+        np.testing.assert_allclose(q, t, rtol = self.tolerance)
+
+    def test_alpha(self):
+        """
+        Test Alpha against a regression of the percentage changes.
+        """
+        periods = 200
+        beta, alpha = qufilab.beta_alpha(self.close, self.high, periods)
+        np.testing.assert_allclose(beta, qufilab.beta(self.close, self.high, periods))
+        np.testing.assert_allclose(alpha, qufilab.alpha(self.close, self.high, periods))
+
+        x = np.diff(self.high) / self.high[:-1] * 100
+        y = np.diff(self.close) / self.close[:-1] * 100
+        slope, intercept = np.polyfit(x[-periods:], y[-periods:], 1)
+        np.testing.assert_allclose(beta[-1], slope, rtol = self.tolerance)
+        np.testing.assert_allclose(alpha[-1], intercept, rtol = self.tolerance)
+
+    def test_universe_beta(self):
+        """
+        Test Beta and Correlation of a panel against a shared market.
+        """
+        periods = 200
+        panel = np.column_stack([self.close, self.open, self.low])
+        beta, corr = qufilab.universe_beta(panel, self.high, periods)
+
+        market = qufilab.pct_change(self.high, 1)
+        for col in range(panel.shape[1]):
+            returns = qufilab.pct_change(panel[:, col], 1)
+            np.testing.assert_allclose(beta[:, col],
+                    qufilab.beta(panel[:, col], self.high, periods), rtol = self.tolerance)
+            np.testing.assert_allclose(corr[:, col],
+                    qufilab.corr(returns, market, periods), rtol = self.tolerance)
+
+    def test_cov_matrix(self):
+        """
+        Test rolling Covariance and Correlation matrices.
+        """
+        periods = 200
+        panel = np.column_stack([self.close, self.open, self.high, self.low])[:10000]
+        cov = qufilab.cov_matrix(panel, periods)
+        corr = qufilab.corr_matrix(panel, periods)
+        self.assertEqual(cov.shape, (10000, 4, 4))
+
+        np.testing.assert_allclose(cov[:, 0, 2],
+                qufilab.cov(panel[:, 0], panel[:, 2], periods), rtol = self.tolerance)
+        np.testing.assert_allclose(corr[:, 1, 3],
+                qufilab.corr(panel[:, 1], panel[:, 3], periods), rtol = self.tolerance)
+
+        final = qufilab.cov_matrix(panel, periods, final = True)
+        np.testing.assert_allclose(final, np.cov(panel[-periods:].T), rtol = self.tolerance)
+        final = qufilab.corr_matrix(panel, periods, final = True)
+        np.testing.assert_allclose(final, np.corrcoef(panel[-periods:].T), rtol = self.tolerance)
+
+    def test_ewma_cov(self):
+        """
+        Test EWMA Covariance and Correlation matrices against weighted sums.
+        """
+        halflife = 20.0
+        panel = np.column_stack([self.close, self.open, self.high]) - 0.5
+        panel = panel[:1000]
+        cov = qufilab.ewma_cov(panel, halflife)
+        final = qufilab.ewma_cov(panel, halflife, final = True)
+        corr = qufilab.ewma_corr(panel, halflife, final = True)
+        np.testing.assert_allclose(cov[-1], final, rtol = self.tolerance)
+
+        weights = 0.5 ** (np.arange(len(panel))[::-1] / halflife)
+        expected = (panel * weights[:, None]).T @ panel / weights.sum()
+        np.testing.assert_allclose(final, expected, rtol = self.tolerance)
+        std = np.sqrt(np.diag(expected))
+        np.testing.assert_allclose(corr, expected / np.outer(std, std), rtol = self.tolerance)
+
+    def test_ewma_corr_nan(self):
+        """
+        Test EWMA Correlation matrix of a panel with NaN against weighted sums
+        over the bars that each pair has in common.
+        """
+        halflife = 20.0
+        panel = np.column_stack([self.close, self.open, self.high])[:1000] - 0.5
+        # The first two series are equal where both are valid, and the first
+        # is small where the second is NaN, so dividing by the variance over
+        # all bars would give a correlation above 1.
+        panel[:, 1] = panel[:, 0]
+        panel[500:700, 0] *= 1e-3
+        panel[500:700, 1] = np.nan
+        panel[::7, 2] = np.nan
+        corr = qufilab.ewma_corr(panel, halflife, final = True)
+
+        weights = 0.5 ** (np.arange(len(panel))[::-1] / halflife)
+        for row in range(3):
+            for col in range(3):
+                common = ~np.isnan(panel[:, row]) & ~np.isnan(panel[:, col])
+                x, y, w = panel[common, row], panel[common, col], weights[common]
+                expected = np.sum(w * x * y) / np.sqrt(np.sum(w * x * x) * np.sum(w * y * y))
+                np.testing.assert_allclose(corr[row, col], expected, rtol = 1e-10)
+
+        self.assertTrue((np.abs(corr) <= 1 + 1e-12).all())
+
+    def test_rolling_extrema(self):
+        """
+        Test rolling maximum/minimum and their positions in the window.
+        """
+        periods = 200
+        np.testing.assert_allclose(qufilab.rolling_max(self.high, periods),
+                talib.MAX(self.high, periods), rtol = self.tolerance)
+        np.testing.assert_allclose(qufilab.rolling_min(self.low, periods),
+                talib.MIN(self.low, periods), rtol = self.tolerance)
+
+        # Talib gives the index in the whole array.
+        start = np.arange(len(self.high)) - periods + 1
+        q = qufilab.rolling_argmax(self.high, periods)
+        t = talib.MAXINDEX(self.high, periods) - start
+        np.testing.assert_array_equal(q[periods - 1:], t[periods - 1:])
+        q = qufilab.rolling_argmin(self.low, periods)
+        t = talib.MININDEX(self.low, periods) - start
+        np.testing.assert_array_equal(q[periods - 1:], t[periods - 1:])
+
     def test_acdi(self):
         """
         Test (Chaikin) Accumulation/Distribution line (ACDI).
@@ -183,6 +623,17 @@ class TestQuant(unittest.TestCase):
         t = talib.AD(self.high, self.low, self.close, self.volume)
         np.testing.assert_allclose(q, t, rtol = self.tolerance)
 
+    def test_cmf(self):
+        """
+        Test Chaikin Money Flow (CMF), the change of ACDI over the period
+        divided by the volume.
+        """
+        periods = 21
+        q = qufilab.cmf(self.close, self.high, self.low, self.volume, periods)
+        ad = talib.AD(self.high, self.low, self.close, self.volume)
+        t = (ad[periods:] - ad[:-periods]) / talib.SUM(self.volume, periods)[periods:]
+        np.testing.assert_allclose(q[periods:], t, rtol = self.tolerance)
+
     def test_bbands(self):
         """
         Test Boolinger Bands.
@@ -193,6 +644,13 @@ class TestQuant(unittest.TestCase):
         np.testing.assert_allclose(q[1], t[1], rtol = self.tolerance)
         np.testing.assert_allclose(q[2], t[2], rtol = self.tolerance)
 
+        percent_b, bandwidth = qufilab.bbands(self.close, 200,
+                outputs = ["percent_b", "bandwidth"])
+        np.testing.assert_allclose(percent_b, (self.close - t[2]) / (t[0] - t[2]),
+                rtol = self.tolerance)
+        np.testing.assert_allclose(bandwidth, (t[0] - t[2]) / t[1], rtol = self.tolerance)
+        np.testing.assert_array_equal(qufilab.bbands(self.close, 200, outputs = "middle"), q[1])
+
     def test_atr(self):
         """
         Test Average True Range (ATR):
@@ -201,6 +659,29 @@ class TestQuant(unittest.TestCase):
         t = talib.ATR(self.high, self.low, self.close, 200)
         np.testing.assert_allclose(q, t, rtol = self.tolerance)
 
+    def test_kc_period(self):
+        """
+        Test that Keltner Channels are NaN for a period below 1, for a single
+        series and a panel written to out.
+        """
+        close, high, low = (x[:1000].reshape(-1, 4) for x in (self.close, self.high, self.low))
+        for period in [0, -3]:
+            for band in qufilab.kc(close[:, 0].copy(), high[:, 0].copy(), low[:, 0].copy(), period):
+                self.assertTrue(np.isnan(band).all())
+
+            out = [np.zeros(close.shape) for _ in range(3)]
+            qufilab.kc(close, high, low, period, out = out)
+            for band in out:
+                self.assertTrue(np.isnan(band).all())
+
+    def test_trange(self):
+        """
+        Test True Range (TRANGE):
+        """
+        q = qufilab.trange(self.close, self.high, self.low)
+        t = talib.TRANGE(self.high, self.low, self.close)
+        np.testing.assert_allclose(q, t, rtol = self.tolerance)
+
     def test_apo(self):
         """
         Test Absolute Price Oscillator (APO).
@@ -209,6 +690,10 @@ class TestQuant(unittest.TestCase):
         t = talib.APO(self.close, 200, 100, 0)
         np.testing.assert_allclose(q, t, rtol = self.tolerance)
 
+        q = qufilab.apo(self.close, 200, 100, "ema")
+        t = talib.APO(self.close, 200, 100, 1)
+        np.testing.assert_allclose(q, t, rtol = self.tolerance)
+
     def test_bop(self):
         """
         Test Balance of Power (BOP).
@@ -233,6 +718,122 @@ class TestQuant(unittest.TestCase):
         t = talib.PPO(self.close, matype = 1)
         np.testing.assert_allclose(q, t, rtol = self.tolerance)
 
+    def test_panel(self):
+        """
+        Test 2D input, with time along both axes.
+        """
+        close = self.close[:100000].reshape(-1, 10)
+        high = self.high[:100000].reshape(-1, 10)
+        low = self.low[:100000].reshape(-1, 10)
+        q = qufilab.atr(close, high, low, 14)
+        q_t = qufilab.atr(close.T, high.T, low.T, 14, axis = 1)
+        self.assertEqual(q.shape, close.shape)
+        np.testing.assert_array_equal(q_t, q.T)
+
+        for col in range(close.shape[1]):
+            t = talib.ATR(high[:, col], low[:, col], close[:, col], 14)
+            np.testing.assert_allclose(q[:, col], t, rtol = self.tolerance)
+
+    def test_panel_lanes(self):
+        """
+        Test that recurrences calculated across symbols give the same values
+        as one symbol at a time.
+        """
+        close = self.close[:200000].reshape(-1, 40)
+        high = self.high[:200000].reshape(-1, 40)
+        low = self.low[:200000].reshape(-1, 40)
+        ema = qufilab.ema(close, 20)
+        smma = qufilab.smma(close, 20)
+        rsi = qufilab.rsi(close, 14)
+        atr = qufilab.atr(close, high, low, 14)
+
+        for col in range(close.shape[1]):
+            np.testing.assert_array_equal(ema[:, col], qufilab.ema(close[:, col].copy(), 20))
+            np.testing.assert_array_equal(smma[:, col], qufilab.smma(close[:, col].copy(), 20))
+            np.testing.assert_array_equal(rsi[:, col], qufilab.rsi(close[:, col].copy(), 14))
+            np.testing.assert_array_equal(atr[:, col], qufilab.atr(close[:, col].copy(),
+                high[:, col].copy(), low[:, col].copy(), 14))
+
+    def test_simd(self):
+        """
+        Test the SIMD code paths of the elementwise indicators.
+        """
+        info = qufilab.simd_info()
+        for name in ["wc", "bop", "roc", "mi", "pct_change", "cci", "trange"]:
+            self.assertIn(info[name], ["scalar", "sse2", "avx2", "avx512"])
+
+        high = np.append(self.high[:10001], self.low[:10001])
+        low = np.append(self.low[:10001], self.low[:10001])
+        q = qufilab.bop(high, low, self.open[:20002], self.close[:20002])
+        with np.errstate(divide = "ignore", invalid = "ignore"):
+            t = np.where(high - low > 0, (self.close[:20002] - self.open[:20002]) / (high - low), 0.0)
+        np.testing.assert_array_equal(q, t)
+
+    def test_threads(self):
+        """
+        Test indicators called from several python threads at once, which
+        calculate without the GIL.
+        """
+        from concurrent.futures import ThreadPoolExecutor
+
+        def work(start):
+            close = self.close[start:start + 100000]
+            high = self.high[start:start + 100000]
+            low = self.low[start:start + 100000]
+            open_ = self.open[start:start + 100000]
+            return (qufilab.sma(close, 20), qufilab.rsi(close, 14),
+                    qufilab.atr(close, high, low, 14), qufilab.hammer(high, low, open_, close))
+
+        starts = range(0, 800000, 100000)
+        with ThreadPoolExecutor(4) as executor:
+            results = list(executor.map(work, starts))
+
+        for start, result in zip(starts, results):
+            for q, q_serial in zip(result, work(start)):
+                np.testing.assert_array_equal(q, q_serial)
+
+    def test_extension(self):
+        """
+        Test that the modules are submodules of the single _qufilab extension.
+        """
+        from qufilab import _qufilab
+        from qufilab.indicators import _trend, _volatility, _momentum, _volume, _stat
+        from qufilab.patterns import _bullish
+
+        self.assertIs(_trend, _qufilab._trend)
+        self.assertIs(_volatility, _qufilab._volatility)
+        self.assertIs(_momentum, _qufilab._momentum)
+        self.assertIs(_volume, _qufilab._volume)
+        self.assertIs(_stat, _qufilab._stat)
+        self.assertIs(_bullish, _qufilab._bullish)
+
+    def test_out(self):
+        """
+        Test that results are written to caller supplied arrays.
+        """
+        close = self.close[:10000]
+        out = np.full(close.shape, 1e10)
+        q = qufilab.rsi(close, 14, out = out)
+        self.assertIs(q, out)
+        np.testing.assert_array_equal(out, qufilab.rsi(close, 14))
+
+        out = (np.empty_like(close), np.empty_like(close), np.empty_like(close))
+        q = qufilab.bbands(close, 20, out = out)
+        for idx in range(3):
+            self.assertIs(q[idx], out[idx])
+            np.testing.assert_array_equal(out[idx], qufilab.bbands(close, 20)[idx])
+
+        data = close.copy()
+        qufilab.ema(data, 20, out = data)
+        np.testing.assert_array_equal(data, qufilab.ema(close, 20))
+
+        out = np.empty(close.shape, dtype = bool)
+        q = qufilab.hammer(self.high[:10000], self.low[:10000], self.open[:10000], close, out = out)
+        self.assertIs(q, out)
+
+        with self.assertRaises(ValueError):
+            qufilab.sma(close, 20, out = np.empty(100))
+
 if __name__ == '__main__':
     unittest.main()
 